@@ -30,6 +30,18 @@ freely, subject to the following restrictions:
 
 #include "main.h"
 
+// Keys read or written for every spawned entity, hashed only once
+static const og::HashedKey KEY_ORIGIN( "origin" );
+static const og::HashedKey KEY_VELOCITY( "velocity" );
+static const og::HashedKey KEY_ROTATION( "rotation" );
+static const og::HashedKey KEY_ROTATION_SPEED( "rotationSpeed" );
+static const og::HashedKey KEY_IMAGE( "image" );
+static const og::HashedKey KEY_IMAGE_SIZE( "imageSize" );
+static const og::HashedKey KEY_RADIUS( "radius" );
+static const og::HashedKey KEY_POP_TIME( "popTime" );
+static const og::HashedKey KEY_SPEED( "speed" );
+static const og::HashedKey KEY_LIFE_TIME( "lifeTime" );
+
 
 /*
 ================
@@ -44,10 +56,10 @@ void SpawnAsteroidsRadial( const char *classname, og::Vec2 origin, int count, fl
 	og::Dict addSettings;
 	for( int i=0; i<count; i++, angle+=angleStep ) {
 		dir.FromAngle( globalRand.RandomFloat( angle-spreadAngle, angle+spreadAngle) );
-		addSettings.Set("origin", origin + dir * globalRand.RandomFloat( minDist, maxDist ) );
-		addSettings.Set("velocity", dir *globalRand.RandomFloat( minSpeed, maxspeed ) );
-		addSettings.Set("rotation", angle);
-		addSettings.Set("rotationSpeed", globalRand.RandomFloat( -maxRot, maxRot));
+		addSettings.Set(KEY_ORIGIN, origin + dir * globalRand.RandomFloat( minDist, maxDist ) );
+		addSettings.Set(KEY_VELOCITY, dir *globalRand.RandomFloat( minSpeed, maxspeed ) );
+		addSettings.Set(KEY_ROTATION, angle);
+		addSettings.Set(KEY_ROTATION_SPEED, globalRand.RandomFloat( -maxRot, maxRot));
 		ogEntityType::SpawnEntity( classname, &addSettings );
 	}
 }
@@ -65,10 +77,10 @@ void SpawnAsteroidsRandom( const char *classname, og::Vec2 origin, int count, fl
 	og::Dict addSettings;
 	for( int i=0; i<count; i++, angle+=angleStep ) {
 		dir.FromAngle( globalRand.RandomFloat( angle-spreadAngle, angle+spreadAngle) );
-		addSettings.Set("origin", origin + dir * globalRand.RandomFloat( minDist, maxDist ) );
+		addSettings.Set(KEY_ORIGIN, origin + dir * globalRand.RandomFloat( minDist, maxDist ) );
 		dir.FromAngle( globalRand.RandomFloat( 0, 360.0f) );
-		addSettings.Set("velocity", dir *globalRand.RandomFloat( minSpeed, maxspeed ) );
-		addSettings.Set("rotationSpeed", globalRand.RandomFloat( -maxRot, maxRot));
+		addSettings.Set(KEY_VELOCITY, dir *globalRand.RandomFloat( minSpeed, maxspeed ) );
+		addSettings.Set(KEY_ROTATION_SPEED, globalRand.RandomFloat( -maxRot, maxRot));
 		ogEntityType::SpawnEntity( classname, &addSettings );
 	}
 }
@@ -104,20 +116,20 @@ ogEntity::Spawn
 ================
 */
 void ogEntity::Spawn( void ) {
-	image = og::Image::Find(settings["image"]);
-	og::Vec2 halfImageSize = settings["imageSize"];
+	image = og::Image::Find(settings[KEY_IMAGE]);
+	og::Vec2 halfImageSize = settings[KEY_IMAGE_SIZE];
 	halfImageSize *= 0.5f;
 	imageVerts[0].Set( -halfImageSize.x, -halfImageSize.y );
 	imageVerts[1].Set( halfImageSize.x, halfImageSize.y );
 	float t = og::Math::Square(halfImageSize.x) + og::Math::Square(halfImageSize.y);
 	if ( t != 0.0f )
 		drawRadius = og::Math::Sqrt(t);
-	origin = settings["origin"];
-	velocity = settings["velocity"];
-	radius = settings["radius"];
-	rotation = settings["rotation"];
-	rotationSpeed = settings["rotationSpeed"];
-	popTime = popTimeFull = settings.Get("popTime", "0.5");
+	origin = settings[KEY_ORIGIN];
+	velocity = settings[KEY_VELOCITY];
+	radius = settings[KEY_RADIUS];
+	rotation = settings[KEY_ROTATION];
+	rotationSpeed = settings[KEY_ROTATION_SPEED];
+	popTime = popTimeFull = settings.Get(KEY_POP_TIME, "0.5");
 }
 
 /*
@@ -405,9 +417,9 @@ void ogPlayer::Attack( void ) {
 	og::Dict addSettings;
 	og::Vec2 dir;
 	dir.FromAngle( rotation-90 );
-	addSettings.Set("origin", origin + dir * radius*0.75f );
-	addSettings.Set("velocity", dir );
-	addSettings.Set("rotation", rotation);
+	addSettings.Set(KEY_ORIGIN, origin + dir * radius*0.75f );
+	addSettings.Set(KEY_VELOCITY, dir );
+	addSettings.Set(KEY_ROTATION, rotation);
 	static_cast<ogPlayer *>( ogEntityType::SpawnEntity( blastClass.c_str(), &addSettings ) );
 	demoWindow.game.PlaySound( settings["snd_shot"], origin );
 }
@@ -428,8 +440,8 @@ ogBlast::Spawn
 ================
 */
 void ogBlast::Spawn( void ) {
-	velocity *= (float)settings["speed"];
-	timeLeft = settings["lifeTime"];
+	velocity *= (float)settings[KEY_SPEED];
+	timeLeft = settings[KEY_LIFE_TIME];
 }
 
 /*
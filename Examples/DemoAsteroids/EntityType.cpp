@@ -40,6 +40,10 @@ freely, subject to the following restrictions:
 og::DictEx<ogEntityType *> ogEntityType::typeDict;
 int ogEntityType::activeTypes = 0;
 
+// Keys looked up for every spawned entity, hashed only once
+static const og::HashedKey KEY_ENTITY_TYPE( "entityType" );
+static const og::HashedKey KEY_NAME( "name" );
+
 /*
 ================
 ogEntityType::ogEntityType
@@ -95,7 +99,7 @@ ogEntity *ogEntityType::SpawnEntity( const char *className, const og::Dict *addi
 
 	const og::Dict &baseDict = demoWindow.game.entityDecls.declList[index];
 
-	const char *entityType = baseDict["entityType"];
+	const char *entityType = baseDict[KEY_ENTITY_TYPE];
 
 	if ( entityType[0] == '\0' )
 		throw ogError( og::Format("Classname '$*' did not define an entityType!" ) << className );
@@ -112,7 +116,7 @@ ogEntity *ogEntityType::SpawnEntity( const char *className, const og::Dict *addi
 
 	if ( additionalSettings ) {
 		ent->settings.Append( *additionalSettings, true );
-		ent->name = additionalSettings->Get( "name", og::Format( "unnamed_entity_$*" ) << demoWindow.game.spawnCount );
+		ent->name = additionalSettings->Get( KEY_NAME, og::Format( "unnamed_entity_$*" ) << demoWindow.game.spawnCount );
 	}
 	else
 		ent->name = og::Format("unnamed_entity_$*") << demoWindow.game.spawnCount;
@@ -114,7 +114,6 @@ bool ogDemoWindow::Init( void ) {
 	InitInput();
 
 	bgLoader.Start();
-	bgLoader.SetNumWorkers(4);
 	const char *extensions[] = { ".tga", ".png", ".jpg", ".dds", NULL };
 	for( int i=0; extensions[i] != NULL; i++ ) {
 		og::FileList *files = og::FS->GetFileList("", extensions[i]);
@@ -168,7 +167,7 @@ void ogDemoWindow::Draw( void ) {
 
 	// finish preloading if not done yet.
 	if ( !bgLoader.IsDone() ) {
-		bgLoader.Synchronize();
+		bgLoader.Synchronize( 4000 );
 		if ( bgLoader.IsDone() ) {
 			bgLoader.Stop();
 			game.Init();
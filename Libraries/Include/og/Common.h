@@ -32,6 +32,8 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <new>
 
 #include <og/Shared.h>
 #include <og/Shared/FileSystemCore.h>
@@ -39,6 +41,8 @@
 // Public Library Includes
 #include <og/Common/Thread/ThreadLocalStorage.h>
 #include <og/Common/Containers/List.h>
+#include <og/Common/Containers/SmallList.h>
+#include <og/Common/Containers/SlotMap.h>
 #include <og/Common/Containers/LinkedList.h>
 #include <og/Common/Containers/Stack.h>
 #include <og/Common/Containers/HashIndex.h>
@@ -55,6 +59,8 @@
 
 // We include .inl files last, so we can access all classes here.
 #include <og/Common/Containers/List.inl>
+#include <og/Common/Containers/SmallList.inl>
+#include <og/Common/Containers/SlotMap.inl>
 #include <og/Common/Containers/LinkedList.inl>
 #include <og/Common/Containers/Stack.inl>
 #include <og/Common/Containers/HashIndex.inl>
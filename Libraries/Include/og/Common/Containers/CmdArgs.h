@@ -38,14 +38,14 @@ namespace og {
 	// ==============================================================================
 	//! Console command arguments
 	// ==============================================================================
-	class CmdArgs : public StringList {
+	class CmdArgs : public SmallStringList<8> {
 	public:
 		// ==============================================================================
 		//! Constructor
 		//!
 		//! @param	str	The string to tokenize
 		// ==============================================================================
-		CmdArgs( const char *str=OG_NULL ) : StringList(16) { if ( str ) TokenizeString( str ); }
+		CmdArgs( const char *str=OG_NULL ) { if ( str ) TokenizeString( str ); }
 
 		// ==============================================================================
 		//! Get the number of arguments
@@ -36,6 +36,65 @@ namespace og {
 //! @defgroup Common Common (Library)
 //! @{
 
+	// ==============================================================================
+	//! Prehashed key for Dict and DictEx lookups
+	//!
+	//! The key gets folded to lower case and hashed once on construction,
+	//! lookups then only compare the folded bytes of the candidates.
+	//! Keep keys for string literals in static objects, so they get hashed only once.
+	// ==============================================================================
+	class HashedKey {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	key	The key string
+		// ==============================================================================
+		explicit HashedKey( const char *key );
+
+		// ==============================================================================
+		//! Get the key string
+		//!
+		//! @return	The key string as it was passed to the constructor
+		// ==============================================================================
+		const char *	GetKey( void ) const { return key.c_str(); }
+
+		// ==============================================================================
+		//! Get the folded key string
+		//!
+		//! @return	The lower case key string
+		// ==============================================================================
+		const String &	GetFolded( void ) const { return folded; }
+
+		// ==============================================================================
+		//! Get the hash key
+		//!
+		//! @return	The case insensitive hash key, as generated by HashIndex::GenerateKey
+		// ==============================================================================
+		int				GetHash( void ) const { return hash; }
+
+		// ==============================================================================
+		//! Check if the key is empty
+		//!
+		//! @return	true if the key string is empty
+		// ==============================================================================
+		bool			IsEmpty( void ) const { return key.IsEmpty(); }
+
+		// ==============================================================================
+		//! Compare against an already folded key
+		//!
+		//! @param	foldedKey	The lower case key string
+		//!
+		//! @return	true if both keys are equal
+		// ==============================================================================
+		bool			Matches( const String &foldedKey ) const;
+
+	private:
+		String	key;		//!< The original key
+		String	folded;		//!< The lower case key
+		int		hash;		//!< The hash key
+	};
+
 	// ==============================================================================
 	//! Key/Value for a Dict
 	// ==============================================================================
@@ -66,6 +125,7 @@ namespace og {
 		friend class Dict;
 		const PoolString *key;		//!< Pointer to the key PoolString
 		const PoolString *value;	//!< Pointer to the value PoolString
+		const PoolString *foldedKey;//!< Pointer to the lower case key PoolString
 	};
 
 	// ==============================================================================
@@ -105,6 +165,7 @@ namespace og {
 		//! @param	key	The key string
 		// ==============================================================================
 		void		Remove( const char *key );
+		void		Remove( const HashedKey &key );
 
 		// ==============================================================================
 		//! Copy all KeyValues from another Dict ( clears existing entries )
@@ -139,8 +200,12 @@ namespace og {
 		void		Set( const char *key, const char *value );
 		void		Set( const char *key, const Format &value );
 		void		Set( const char *key, const String &value );
+		void		Set( const HashedKey &key, const char *value );
+		void		Set( const HashedKey &key, const Format &value );
+		void		Set( const HashedKey &key, const String &value );
 
 		template<class T> void Set( const char *key, const T &value );
+		template<class T> void Set( const HashedKey &key, const T &value );
 
 		// ==============================================================================
 		//! Get the value for the specified key
@@ -151,6 +216,7 @@ namespace og {
 		//! @return	A temporary object to use for conversion to other types
 		// ==============================================================================
 		StringType	Get( const char *key, const char *defaultValue ) const;
+		StringType	Get( const HashedKey &key, const char *defaultValue ) const;
 
 		// ==============================================================================
 		//! Get the value for the specified key and find out if the key existed
@@ -162,6 +228,7 @@ namespace og {
 		//! @return	true if the key existed
 		// ==============================================================================
 		template<class T> bool Get( const char *key, const char *defaultValue, T &value ) const;
+		template<class T> bool Get( const HashedKey &key, const char *defaultValue, T &value ) const;
 
 		// ==============================================================================
 		//! Find the index of the specified key
@@ -171,6 +238,7 @@ namespace og {
 		//! @return	Zero-based index of the key, -1 if not found.
 		// ==============================================================================
 		int			Find( const char *key ) const;
+		int			Find( const HashedKey &key ) const;
 
 		// ==============================================================================
 		//! Find all entries that start with a prefix
@@ -215,6 +283,7 @@ namespace og {
 		//! @return	A temporary object to use for conversion to other types
 		// ==============================================================================
 		StringType	operator[]( const char *key ) const;
+		StringType	operator[]( const HashedKey &key ) const;
 
 		// ==============================================================================
 		//! Get a value by its index
@@ -226,6 +295,23 @@ namespace og {
 		StringType	operator[]( int index ) const;
 
 	private:
+		// ==============================================================================
+		//! Add a new entry
+		//!
+		//! @param	hash		The hash key
+		//! @param	key			The key
+		//! @param	foldedKey	The lower case key
+		//! @param	value		The value
+		// ==============================================================================
+		void		AddEntry( int hash, const char *key, const char *foldedKey, const char *value );
+
+		// ==============================================================================
+		//! Free the strings of an entry
+		//!
+		//! @param	index	Zero-based index
+		// ==============================================================================
+		void		FreeEntry( int index );
+
 		static TLS<StringPool>	keyPool;	//!< The key pool ( thread local )
 		static TLS<StringPool>	valuePool;	//!< The value pool ( thread local )
 
@@ -310,6 +396,7 @@ namespace og {
 		//! @return	Zero-based index of the key, -1 if not found.
 		// ==============================================================================
 		int			Find( const char *key ) const;
+		int			Find( const HashedKey &key ) const;
 		
 		// ==============================================================================
 		//! Find the first index of the entry where the value matches the specified one
@@ -350,6 +437,7 @@ namespace og {
 		// ==============================================================================
 		const T &	operator[]( const char *key ) const;
 		T &			operator[]( const char *key );
+		T &			operator[]( const HashedKey &key );
 
 		// ==============================================================================
 		//! Get a value by its index
@@ -364,7 +452,19 @@ namespace og {
 	protected:
 		ListEx<T>	entries;	//!< The entries list
 		StringList	names;		//!< The key names list
+		StringList	foldedNames;//!< The lower case key names list
 		HashIndex	hashIndex;	//!< Hash index for faster key access
+
+		// ==============================================================================
+		//! Add a new entry
+		//!
+		//! @param	hash		The hash key
+		//! @param	key			The key
+		//! @param	foldedKey	The lower case key
+		//!
+		//! @return	A reference to the new object
+		// ==============================================================================
+		T &			AddEntry( int hash, const char *key, const char *foldedKey );
 	};
 //! @}
 }
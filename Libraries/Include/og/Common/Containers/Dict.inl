@@ -32,6 +32,34 @@ freely, subject to the following restrictions:
 
 namespace og {
 
+/*
+==============================================================================
+
+  HashedKey
+
+==============================================================================
+*/
+
+/*
+================
+HashedKey::HashedKey
+================
+*/
+OG_INLINE HashedKey::HashedKey( const char *key ) : key(key), folded(key) {
+	folded.ToLower();
+	hash = HashIndex::GenerateKey( key, false );
+}
+
+/*
+================
+HashedKey::Matches
+================
+*/
+OG_INLINE bool HashedKey::Matches( const String &foldedKey ) const {
+	return foldedKey.ByteLength() == folded.ByteLength()
+		&& memcmp( foldedKey.c_str(), folded.c_str(), folded.ByteLength() ) == 0;
+}
+
 /*
 ==============================================================================
 
@@ -47,6 +75,7 @@ Dict::Dict
 */
 OG_INLINE Dict::Dict() {
 	SetGranularity(16);
+	entries.SetGeometricGrowth( true );
 }
 
 /*
@@ -88,11 +117,27 @@ OG_INLINE void Dict::Set( const char *key, const String &value ) {
 OG_INLINE void Dict::Set( const char *key, const Format &value ) {
 	Set( key, value.c_str() );
 }
+OG_INLINE void Dict::Set( const HashedKey &key, const String &value ) {
+	Set( key, value.c_str() );
+}
+OG_INLINE void Dict::Set( const HashedKey &key, const Format &value ) {
+	Set( key, value.c_str() );
+}
 template<class T>
 void Dict::Set( const char *key, const T &value ) {
 	Set( key, (Format() << value).c_str() );
 }
 template<class T>
+void Dict::Set( const HashedKey &key, const T &value ) {
+	Set( key, (Format() << value).c_str() );
+}
+
+/*
+================
+Dict::Get
+================
+*/
+template<class T>
 bool Dict::Get( const char *key, const char *defaultValue, T &out ) const {
 	int index = Find( key );
 	if ( index == -1 ) {
@@ -102,6 +147,16 @@ bool Dict::Get( const char *key, const char *defaultValue, T &out ) const {
 	out = entries[index].GetValue();
 	return true;
 }
+template<class T>
+bool Dict::Get( const HashedKey &key, const char *defaultValue, T &out ) const {
+	int index = Find( key );
+	if ( index == -1 ) {
+		out = StringType( defaultValue );
+		return false;
+	}
+	out = entries[index].GetValue();
+	return true;
+}
 
 /*
 ================
@@ -111,6 +166,9 @@ Dict::operator[]
 OG_INLINE StringType Dict::operator[]( const char *key ) const {
 	return Get(key, "");
 }
+OG_INLINE StringType Dict::operator[]( const HashedKey &key ) const {
+	return Get(key, "");
+}
 OG_INLINE StringType Dict::operator[]( int index ) const {
 	OG_ASSERT( index >= 0 && index <= entries.Num() );
 	return entries[index].GetValue();
@@ -143,6 +201,9 @@ DictEx::DictEx
 template<class T>
 OG_INLINE DictEx<T>::DictEx() {
 	SetGranularity(16);
+	entries.SetGeometricGrowth( true );
+	names.SetGeometricGrowth( true );
+	foldedNames.SetGeometricGrowth( true );
 }
 
 /*
@@ -154,6 +215,7 @@ template<class T>
 void DictEx<T>::Clear( void ) {
 	entries.Clear();
 	names.Clear();
+	foldedNames.Clear();
 	hashIndex.Clear();
 }
 
@@ -166,6 +228,7 @@ template<class T>
 OG_INLINE void DictEx<T>::SetGranularity( int granularity ) {
 	entries.SetGranularity( granularity );
 	names.SetGranularity( granularity );
+	foldedNames.SetGranularity( granularity );
 }
 
 /*
@@ -190,6 +253,7 @@ void DictEx<T>::Remove( const char *key ) {
 		if ( names[i].Icmp( key ) == 0 ) {
 			entries.Remove( i );
 			names.Remove( i );
+			foldedNames.Remove( i );
 			hashIndex.Remove( hash, i );
 			return;
 		}
@@ -208,6 +272,7 @@ void DictEx<T>::Remove( int index ) {
 	hashIndex.Remove( hashIndex.GenerateKey( names[index].c_str(), false ), index );
 	entries.Remove( index );
 	names.Remove( index );
+	foldedNames.Remove( index );
 }
 
 /*
@@ -223,6 +288,7 @@ void DictEx<T>::Copy( const DictEx<T> &other ) {
 		const String &key = other.GetKey(i);
 		hashIndex.Add( hashIndex.GenerateKey( key.c_str(), false ), entries.Num() );
 		names.Append( key );
+		foldedNames.Append( other.foldedNames[i] );
 		entries.Append( other[i] );
 	}
 }
@@ -247,6 +313,7 @@ void DictEx<T>::Append( const DictEx<T> &other, bool overWrite ) {
 		}
 		hashIndex.Add( hashIndex.GenerateKey( key.c_str(), false ), entries.Num() );
 		names.Append( key );
+		foldedNames.Append( other.foldedNames[i] );
 		entries.Append( other[i] );
 	}
 }
@@ -280,6 +347,18 @@ int DictEx<T>::Find( const char *key ) const {
 
 	return -1;
 }
+template<class T>
+int DictEx<T>::Find( const HashedKey &key ) const {
+	if ( key.IsEmpty() )
+		return -1;
+
+	for ( int i = hashIndex.First( key.GetHash() ); i != -1; i = hashIndex.Next() ) {
+		if ( key.Matches( foldedNames[i] ) )
+			return i;
+	}
+
+	return -1;
+}
 
 /*
 ================
@@ -320,10 +399,8 @@ OG_INLINE const T &DictEx<T>::operator[]( const char *key ) const {
 	if ( index != -1 )
 		return entries[index];
 
-	// Not found, create one
-	hashIndex.Add( hashIndex.GenerateKey( key, false ), entries.Num() );
-	names.Append(key);
-	return entries.Alloc();
+	// Not found, create one through the non-const version, so all key lists stay in sync
+	return const_cast<DictEx<T> *>( this )->operator[]( key );
 }
 template<class T>
 OG_INLINE T &DictEx<T>::operator[]( const char *key ) {
@@ -332,9 +409,18 @@ OG_INLINE T &DictEx<T>::operator[]( const char *key ) {
 		return entries[index];
 
 	// Not found, create one
-	hashIndex.Add( hashIndex.GenerateKey( key, false ), entries.Num() );
-	names.Append(key);
-	return entries.Alloc();
+	String folded( key );
+	folded.ToLower();
+	return AddEntry( hashIndex.GenerateKey( key, false ), key, folded.c_str() );
+}
+template<class T>
+OG_INLINE T &DictEx<T>::operator[]( const HashedKey &key ) {
+	int index = Find( key );
+	if ( index != -1 )
+		return entries[index];
+
+	// Not found, create one
+	return AddEntry( key.GetHash(), key.GetKey(), key.GetFolded().c_str() );
 }
 
 /*
@@ -364,6 +450,19 @@ OG_INLINE DictEx<T> &DictEx<T>::operator=( const DictEx<T> &other ) {
 	return *this;
 }
 
+/*
+================
+DictEx::AddEntry
+================
+*/
+template<class T>
+T &DictEx<T>::AddEntry( int hash, const char *key, const char *foldedKey ) {
+	hashIndex.Add( hash, entries.Num() );
+	names.Append( key );
+	foldedNames.Append( foldedKey );
+	return entries.Alloc();
+}
+
 }
 
 #endif
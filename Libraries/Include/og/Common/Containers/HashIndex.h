@@ -37,13 +37,19 @@ namespace og {
 
 	// ==============================================================================
 	//! Hash index
+	//!
+	//! Maps hash values to indices of an external list.
+	//! All entries live in one flat array ( open addressing, robin hood hashing ),
+	//! so adding an entry never allocates unless the array needs to grow.
+	//! The full hash is stored with every entry, so First() and Next() only return
+	//! indices with exactly the same hash and the caller rarely has to compare a string in vain.
 	// ==============================================================================
 	class HashIndex {
 	public:
 		// ==============================================================================
 		//! Constructor
 		//!
-		//! @param	hashSize	Size of the hash
+		//! @param	hashSize	Initial number of slots, must be a power of two ( grows when 3/4 are used )
 		// ==============================================================================
 		HashIndex( int hashSize=128 );
 
@@ -68,13 +74,35 @@ namespace og {
 		void	Add( int hash, int index );
 
 		// ==============================================================================
-		//! Remove this entry
+		//! Remove this entry and decrease all indices above it
 		//!
 		//! @param	hash	The hash entry
 		//! @param	index	Zero-based index
+		//!
+		//! @note	Use this when the entry got removed from a List with List::Remove.
+		//!			Decreasing the other indices is a linear pass over the slots.
 		// ==============================================================================
 		void	Remove( int hash, int index );
 
+		// ==============================================================================
+		//! Remove this entry, leaving all other indices as they are
+		//!
+		//! @param	hash	The hash entry
+		//! @param	index	Zero-based index
+		// ==============================================================================
+		void	RemoveFast( int hash, int index );
+
+		// ==============================================================================
+		//! Change the index of an entry
+		//!
+		//! @param	hash		The hash entry
+		//! @param	oldIndex	The current index
+		//! @param	newIndex	The new index
+		//!
+		//! @note	Together with RemoveFast, this keeps up with List::RemoveFast in constant time
+		// ==============================================================================
+		void	Move( int hash, int oldIndex, int newIndex );
+
 		// ==============================================================================
 		//! Get the first entry with the specified hash value
 		//!
@@ -103,26 +131,51 @@ namespace og {
 		static int GenerateKey( const char *value, bool caseSensitive );
 
 	private:
+		// ==============================================================================
+		//! Hash index slot
+		// ==============================================================================
+		struct Slot {
+			int		hash;	//!< The full hash value
+			int		index;	//!< The index, -1 if this slot is empty
+		};
 
 		// ==============================================================================
-		//! Initialize the hash list
+		//! Allocate the slots
+		//!
+		//! @param	size	Number of slots, a power of two
 		// ==============================================================================
-		void	Init( void );
+		void	Init( int size );
 
-		int		hashSize;		//!< Size of the hash list, bigger hashsize = less collisions, but more memory
-		int		mask;			//!< The hash mask
-		bool	initialized;	//!< true when the hash list is initialized
+		// ==============================================================================
+		//! Insert an entry without checking for duplicates
+		// ==============================================================================
+		void	Insert( int hash, int index );
 
 		// ==============================================================================
-		//! Hash index node
+		//! Find the slot of an entry
+		//!
+		//! @return	-1 if not found, otherwise the slot index
 		// ==============================================================================
-		struct HashIndexNode_s {
-			HashIndexNode_s *next;
-			int				index;
-		};
-		HashIndexNode_s **nodeList;			//!< List of nodelists
-		List<HashIndexNode_s *> allnodes;	//!< List of all nodes
-		mutable HashIndexNode_s *findNode;	//!< The find node
+		int		FindSlot( int hash, int index ) const;
+
+		// ==============================================================================
+		//! Empty a slot and move the following entries back
+		// ==============================================================================
+		void	EraseSlot( int pos );
+
+		// ==============================================================================
+		//! Distance of the slot from the one the hash maps to
+		// ==============================================================================
+		int		ProbeDistance( int pos, int hash ) const { return (pos - hash) & mask; }
+
+		int		hashSize;		//!< Number of slots, bigger hashsize = less collisions, but more memory
+		int		mask;			//!< The hash mask
+		int		numEntries;		//!< Number of used slots
+		Slot *	slots;			//!< The slots, OG_NULL until the first entry gets added
+
+		mutable int	findHash;	//!< The hash First() was called with
+		mutable int	findPos;	//!< The next slot to look at
+		mutable int	findDist;	//!< The probe distance of findPos
 	};
 //! @}
 }
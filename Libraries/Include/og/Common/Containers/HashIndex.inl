@@ -46,26 +46,34 @@ HashIndex::First
 ================
 */
 OG_INLINE int HashIndex::First( int hash ) const {
-	if ( initialized ) {
-		findNode = nodeList[(hash & mask)];
-		if ( findNode )
-			return findNode->index;
-	}
-	return -1;
+	if ( slots == OG_NULL )
+		return -1;
+	findHash = hash;
+	findPos = hash & mask;
+	findDist = 0;
+	return Next();
 }
 
 /*
 ================
 HashIndex::Next
+
+Robin hood hashing keeps entries sorted by probe distance,
+so once a slot is closer to its origin than we are to ours, we're done.
 ================
 */
 OG_INLINE int HashIndex::Next( void ) const {
-	if ( initialized && findNode ) {
-		findNode = findNode->next;
-		if ( findNode )
-			return findNode->index;
+	if ( slots == OG_NULL )
+		return -1;
+	for(;;) {
+		const Slot &slot = slots[findPos];
+		if ( slot.index == -1 || ProbeDistance( findPos, slot.hash ) < findDist )
+			return -1;
+		findPos = (findPos + 1) & mask;
+		findDist++;
+		if ( slot.hash == findHash )
+			return slot.index;
 	}
-	return -1;
 }
 
 /*
@@ -39,8 +39,9 @@ namespace og {
 	// ==============================================================================
 	//! List -> use for small items
 	//!
-	//! @note	Everytime the list gets resized, it will create a new array of items
-	//!			and delete the old one. This is very inefficient for bigger items.
+	//! @note	Everytime the list gets resized, it will move the items into a new array
+	//!			and delete the old one. Relocatable items ( see IsRelocatable ) are moved with memcpy,
+	//!			all others get copy constructed, which is inefficient for bigger items.
 	//!	@warning	If you decide to use List with a class/struct, which contains
 	//!				dynamic memory, make sure the class has a copy constructor.
 	// ==============================================================================
@@ -116,6 +117,16 @@ namespace og {
 		// ==============================================================================
 		int			GetGranularity( void ) const;
 
+		// ==============================================================================
+		//! Enable geometric growth
+		//!
+		//! @param	enable	true to grow by at least the current size on each resize,
+		//!					rather than just by the granularity
+		//!
+		//! @note	Use this on lists that grow big, so appending stays linear
+		// ==============================================================================
+		void		SetGeometricGrowth( bool enable );
+
 		// ==============================================================================
 		//! Get the next unused item, resize the list if needed
 		//!
@@ -131,6 +142,35 @@ namespace og {
 		// ==============================================================================
 		void		EnsureAllocated( int count, bool keepContent=true );
 
+		// ==============================================================================
+		//! Make sure there is room for n items, without changing the number of entries
+		//!
+		//! @param	count	The number of items to make room for
+		// ==============================================================================
+		void		Reserve( int count );
+
+		// ==============================================================================
+		//! Free the memory of the unused items
+		// ==============================================================================
+		void		ShrinkToFit( void );
+
+		// ==============================================================================
+		//! Construct a new item in place, resize the list if needed
+		//!
+		//! @param	a1, a2, a3	The constructor arguments
+		//!
+		//! @return	a reference to the new object
+		//!
+		//! @note	The arguments must not reference items of this list
+		// ==============================================================================
+		T &			EmplaceBack( void );
+		template<class A1>
+		T &			EmplaceBack( const A1 &a1 );
+		template<class A1, class A2>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2 );
+		template<class A1, class A2, class A3>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 );
+
 		// ==============================================================================
 		//! Add a new item, resize the list if needed
 		//!
@@ -145,6 +185,15 @@ namespace og {
 		// ==============================================================================
 		void		Remove( int index );
 
+		// ==============================================================================
+		//! Remove an item by moving the last item into its place (list won't be resized)
+		//!
+		//! @param	index	The index to remove
+		//!
+		//! @note	Faster than Remove, but the order of the items is not kept
+		// ==============================================================================
+		void		RemoveFast( int index );
+
 		// ==============================================================================
 		//! Copy data from an existing list
 		//!
@@ -218,6 +267,16 @@ namespace og {
 		int			num;			//<! Number of used items
 		int			size;			//<! Total number of items
 		T *			list;			//<! Pointer to the list
+		bool		geometric;		//<! Grow by at least the current size everytime it needs resizing
+
+		// ==============================================================================
+		//! Get the size to use when growing the list
+		//!
+		//! @param	newSize		The number of items needed
+		//!
+		//! @return	The new list size
+		// ==============================================================================
+		int			GetGrowSize( int newSize ) const;
 
 		// ==============================================================================
 		//! Resize to the size and (optional) keep the content
@@ -227,6 +286,13 @@ namespace og {
 		// ==============================================================================
 		void		Resize( int newSize, bool keepContent );
 
+		// ==============================================================================
+		//! Sort the items by a list of their indices
+		//!
+		//! @param	order	The indices in the new order
+		// ==============================================================================
+		void		Reorder( List<int> &order );
+
 		// ==============================================================================
 		//! Comparison callback
 		//!
@@ -247,14 +313,37 @@ namespace og {
 		// ==============================================================================
 		static int	CompareCallbackEx( void *context, const void *a, const void *b );
 
+		// ==============================================================================
+		//! Comparison callback for sorting indices
+		//!
+		//! @param	context	A pointer to the CompareData object
+		//! @param	a		A pointer to the first index
+		//! @param	b		A pointer to the second index
+		//!
+		//! @return	0 if the objects match, otherwise positive or negative
+		// ==============================================================================
+		static int	CompareIndexCallback( void *context, const void *a, const void *b );
+
+		// ==============================================================================
+		//! Comparison callback for sorting indices
+		//!
+		//! @param	context	A pointer to the CompareDataEx object
+		//! @param	a		A pointer to the first index
+		//! @param	b		A pointer to the second index
+		//!
+		//! @return	0 if the objects match, otherwise positive or negative
+		// ==============================================================================
+		static int	CompareIndexCallbackEx( void *context, const void *a, const void *b );
+
 		// ==============================================================================
 		//! Comparison data
 		// ==============================================================================
 		class CompareData {
 		public:
-			CompareData( cmpFunc_t f ) : func(f) {}
+			CompareData( cmpFunc_t f, const T *i=OG_NULL ) : func(f), items(i) {}
 
 			cmpFunc_t	func;		//!< The normal comparison function
+			const T *	items;		//!< The items to compare ( when sorting indices )
 		};
 
 		// ==============================================================================
@@ -262,10 +351,11 @@ namespace og {
 		// ==============================================================================
 		class CompareDataEx {
 		public:
-			CompareDataEx( cmpFuncEx_t f, void *p ) : func(f), param(p) {}
+			CompareDataEx( cmpFuncEx_t f, void *p, const T *i=OG_NULL ) : func(f), param(p), items(i) {}
 
 			cmpFuncEx_t	func;		//!< The extended comparison function
 			void		*param;		//!< The parameter ( for the extended comparison )
+			const T *	items;		//!< The items to compare ( when sorting indices )
 		};
 	};
 
@@ -348,6 +438,16 @@ namespace og {
 		// ==============================================================================
 		int			GetGranularity( void ) const;
 
+		// ==============================================================================
+		//! Enable geometric growth
+		//!
+		//! @param	enable	true to grow by at least the current size on each resize,
+		//!					rather than just by the granularity
+		//!
+		//! @note	Use this on lists that grow big, so appending stays linear
+		// ==============================================================================
+		void		SetGeometricGrowth( bool enable );
+
 		// ==============================================================================
 		//! Get the next unused item, resize the list if needed
 		//!
@@ -363,6 +463,33 @@ namespace og {
 		// ==============================================================================
 		void		EnsureAllocated( int count, bool keepContent=true );
 
+		// ==============================================================================
+		//! Make sure there is room for n item pointers, without changing the number of entries
+		//!
+		//! @param	count	The number of items to make room for
+		// ==============================================================================
+		void		Reserve( int count );
+
+		// ==============================================================================
+		//! Free the memory of the unused item pointers
+		// ==============================================================================
+		void		ShrinkToFit( void );
+
+		// ==============================================================================
+		//! Construct a new item, resize the list if needed
+		//!
+		//! @param	a1, a2, a3	The constructor arguments
+		//!
+		//! @return	a reference to the new object
+		// ==============================================================================
+		T &			EmplaceBack( void );
+		template<class A1>
+		T &			EmplaceBack( const A1 &a1 );
+		template<class A1, class A2>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2 );
+		template<class A1, class A2, class A3>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 );
+
 		// ==============================================================================
 		//! Add a new item, resize the list if needed
 		//!
@@ -377,6 +504,15 @@ namespace og {
 		// ==============================================================================
 		void		Remove( int index );
 
+		// ==============================================================================
+		//! Remove an item by moving the last item into its place (list won't be resized)
+		//!
+		//! @param	index	The index to remove
+		//!
+		//! @note	Faster than Remove, but the order of the items is not kept
+		// ==============================================================================
+		void		RemoveFast( int index );
+
 		// ==============================================================================
 		//! Copy data from an existing list
 		//!
@@ -450,6 +586,16 @@ namespace og {
 		int			num;			//<! Number of used items
 		int			size;			//<! Total number of item pointers
 		T **		list;			//<! Pointer to the list
+		bool		geometric;		//<! Grow by at least the current size everytime it needs resizing
+
+		// ==============================================================================
+		//! Get the size to use when growing the list
+		//!
+		//! @param	newSize		The number of item pointers needed
+		//!
+		//! @return	The new list size
+		// ==============================================================================
+		int			GetGrowSize( int newSize ) const;
 
 		// ==============================================================================
 		//! Resize to the size and (optional) keep the content
@@ -48,8 +48,10 @@ List::List
 template<class T>
 OG_INLINE List<T>::List( int _granularity ) {
 	list		= OG_NULL;
+	num			= 0;
+	size		= 0;
 	granularity = _granularity;
-	Clear();
+	geometric	= false;
 }
 
 /*
@@ -59,8 +61,11 @@ List::List
 */
 template<class T>
 OG_INLINE List<T>::List( const List<T> &other ) {
-	list = OG_NULL;
+	list		= OG_NULL;
+	num			= 0;
+	size		= 0;
 	granularity = other.granularity;
+	geometric	= other.geometric;
 	Copy(other);
 }
 
@@ -81,7 +86,10 @@ List::Clear
 */
 template<class T>
 void List<T>::Clear( void ) {
-	SafeDeleteArray( list );
+	for ( int i=0; i<num; i++ )
+		list[i].~T();
+	::operator delete( list );
+	list	= OG_NULL;
 	num		= 0;
 	size	= 0;
 }
@@ -138,6 +146,16 @@ OG_INLINE int List<T>::GetGranularity( void ) const {
 	return granularity;
 }
 
+/*
+================
+List::SetGeometricGrowth
+================
+*/
+template<class T>
+OG_INLINE void List<T>::SetGeometricGrowth( bool enable ) {
+	geometric = enable;
+}
+
 /*
 ================
 List::operator[]
@@ -161,7 +179,7 @@ List::operator+=
 */
 template<class T>
 OG_INLINE void List<T>::operator+=( T value ) {
-	Alloc() = value;
+	EmplaceBack( value );
 }
 
 /*
@@ -175,8 +193,10 @@ copy all items from the other list.
 template<class T>
 void List<T>::Copy( const List<T> &other ) {
 	Clear();
+	Reserve( other.num );
 	for( int i=0; i<other.num; i++ )
-		Alloc() = other[i];
+		new( list + i ) T( other.list[i] );
+	num = other.num;
 }
 
 /*
@@ -188,7 +208,8 @@ Synonym for Copy
 */
 template<class T>
 OG_INLINE List<T> &List<T>::operator=( const List<T> &other ) {
-	Copy(other);
+	if ( &other != this )
+		Copy(other);
 	return *this;
 }
 
@@ -202,7 +223,31 @@ Calls Resize if needed
 template<class T>
 OG_INLINE void List<T>::CheckSize( int newSize, bool keepContent ) {
 	if ( newSize > size )
-		Resize( newSize, keepContent );
+		Resize( GetGrowSize( newSize ), keepContent );
+}
+
+/*
+================
+List::Reserve
+================
+*/
+template<class T>
+void List<T>::Reserve( int count ) {
+	if ( count > size )
+		Resize( count, true );
+}
+
+/*
+================
+List::ShrinkToFit
+================
+*/
+template<class T>
+void List<T>::ShrinkToFit( void ) {
+	if ( num == 0 )
+		Clear();
+	else if ( num < size )
+		Resize( num, true );
 }
 
 /*
@@ -216,8 +261,41 @@ in the list and resizes if needed.
 template<class T>
 T& List<T>::Alloc( void ) {
 	CheckSize( num+1 );
-	num++;
-	return list[num-1];
+	new( list + num ) T;
+	return list[num++];
+}
+
+/*
+================
+List::EmplaceBack
+================
+*/
+template<class T>
+OG_INLINE T& List<T>::EmplaceBack( void ) {
+	CheckSize( num+1 );
+	new( list + num ) T();
+	return list[num++];
+}
+template<class T>
+template<class A1>
+OG_INLINE T& List<T>::EmplaceBack( const A1 &a1 ) {
+	CheckSize( num+1 );
+	new( list + num ) T( a1 );
+	return list[num++];
+}
+template<class T>
+template<class A1, class A2>
+OG_INLINE T& List<T>::EmplaceBack( const A1 &a1, const A2 &a2 ) {
+	CheckSize( num+1 );
+	new( list + num ) T( a1, a2 );
+	return list[num++];
+}
+template<class T>
+template<class A1, class A2, class A3>
+OG_INLINE T& List<T>::EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 ) {
+	CheckSize( num+1 );
+	new( list + num ) T( a1, a2, a3 );
+	return list[num++];
 }
 
 /*
@@ -229,7 +307,10 @@ template<class T>
 void List<T>::EnsureAllocated( int count, bool keepContent ) {
 	OG_ASSERT(count > 0);
 	CheckSize( count, keepContent );
-	num = count;
+	while( num < count )
+		new( list + num++ ) T;
+	while( num > count )
+		list[--num].~T();
 }
 
 /*
@@ -239,7 +320,7 @@ List::Append
 */
 template<class T>
 OG_INLINE void List<T>::Append( T value ) {
-	Alloc() = value;
+	EmplaceBack( value );
 }
 
 /*
@@ -254,11 +335,30 @@ template<class T>
 void List<T>::Remove( int index ) {
 	OG_ASSERT( index >= 0 && index < num );
 
-	for ( int i=index; i<num; i++ ) {
-		if ( (i+1) < num )
+	num--;
+	if ( IsRelocatable<T>::value ) {
+		list[index].~T();
+		memmove( static_cast<void *>( list + index ), list + index + 1, (num - index) * sizeof( T ) );
+	} else {
+		for ( int i=index; i<num; i++ )
 			list[i] = list[i+1];
+		list[num].~T();
 	}
+}
+
+/*
+================
+List::RemoveFast
+================
+*/
+template<class T>
+void List<T>::RemoveFast( int index ) {
+	OG_ASSERT( index >= 0 && index < num );
+
 	num--;
+	if ( index != num )
+		list[index] = list[num];
+	list[num].~T();
 }
 
 /*
@@ -283,6 +383,9 @@ int List<T>::Find( T value ) const {
 List::Sort
 
 Sorts the list and removes duplicates.
+QuickSort works on bytes, so unless the items
+are relocatable, the indices get sorted and
+the items moved afterwards.
 ================
 */
 template<class T>
@@ -290,8 +393,19 @@ void List<T>::Sort( cmpFunc_t compare, bool removeDupes ) {
 	if ( num < 2 )
 		return;
 
-	CompareData cmpData( compare );
-	QuickSort( list, num, sizeof( T * ), &cmpData, CompareCallback );
+	if ( IsRelocatable<T>::value ) {
+		CompareData cmpData( compare );
+		QuickSort( list, num, sizeof( T ), &cmpData, CompareCallback );
+	} else {
+		List<int> order;
+		order.Reserve( num );
+		for ( int i=0; i<num; i++ )
+			order.Append( i );
+
+		CompareData cmpData( compare, list );
+		QuickSort( &order[0], num, sizeof( int ), &cmpData, CompareIndexCallback );
+		Reorder( order );
+	}
 
 	if ( removeDupes ) {
 		for ( int i=num-2; i>=0; i-- ) {
@@ -313,8 +427,19 @@ void List<T>::SortEx( cmpFuncEx_t compare, void *param, bool removeDupes ) {
 	if ( num < 2 )
 		return;
 
-	CompareDataEx cmpData( compare, param );
-	QuickSort( list, num, sizeof( T * ), &cmpData, CompareCallbackEx );
+	if ( IsRelocatable<T>::value ) {
+		CompareDataEx cmpData( compare, param );
+		QuickSort( list, num, sizeof( T ), &cmpData, CompareCallbackEx );
+	} else {
+		List<int> order;
+		order.Reserve( num );
+		for ( int i=0; i<num; i++ )
+			order.Append( i );
+
+		CompareDataEx cmpData( compare, param, list );
+		QuickSort( &order[0], num, sizeof( int ), &cmpData, CompareIndexCallbackEx );
+		Reorder( order );
+	}
 
 	if ( removeDupes ) {
 		for ( int i=num-2; i>=0; i-- ) {
@@ -324,6 +449,34 @@ void List<T>::SortEx( cmpFuncEx_t compare, void *param, bool removeDupes ) {
 	}
 }
 
+/*
+================
+List::Reorder
+
+Follows each cycle of the permutation,
+so every item gets moved just once.
+================
+*/
+template<class T>
+void List<T>::Reorder( List<int> &order ) {
+	for ( int start=0; start<num; start++ ) {
+		if ( order[start] == start )
+			continue;
+
+		T temp( list[start] );
+		int i = start;
+		int next = order[i];
+		while ( next != start ) {
+			list[i] = list[next];
+			order[i] = i;
+			i = next;
+			next = order[i];
+		}
+		list[i] = temp;
+		order[i] = i;
+	}
+}
+
 /*
 ================
 List::CompareCallback
@@ -346,31 +499,76 @@ int List<T>::CompareCallbackEx( void *context, const void *a, const void *b ) {
 	return cmpData->func( *(const T *)a, *(const T *)b, cmpData->param );
 }
 
+/*
+================
+List::CompareIndexCallback
+================
+*/
+template<class T>
+int List<T>::CompareIndexCallback( void *context, const void *a, const void *b ) {
+	CompareData *cmpData = reinterpret_cast<CompareData *>(context);
+	return cmpData->func( cmpData->items[*(const int *)a], cmpData->items[*(const int *)b] );
+}
+
+/*
+================
+List::CompareIndexCallbackEx
+================
+*/
+template<class T>
+int List<T>::CompareIndexCallbackEx( void *context, const void *a, const void *b ) {
+	CompareDataEx *cmpData = reinterpret_cast<CompareDataEx *>(context);
+	return cmpData->func( cmpData->items[*(const int *)a], cmpData->items[*(const int *)b], cmpData->param );
+}
+
+/*
+================
+List::GetGrowSize
+
+Round up to the granularity,
+and grow by at least the current size
+if geometric growth is enabled.
+================
+*/
+template<class T>
+int List<T>::GetGrowSize( int newSize ) const {
+	int count = ( ( newSize + granularity - 1 ) / granularity ) * granularity;
+	if ( geometric && count < size * 2 )
+		count = size * 2;
+	return count;
+}
+
 /*
 ================
 List::Resize
 
-Create a new list with n items.
-(Checks for granularity)
-Copies all of the content if wanted.
+Create a new list with room for n items.
+Moves all of the content if wanted,
+relocatable items just get copied bitwise.
 Old list will be freed.
 ================
 */
 template<class T>
 void List<T>::Resize( int newSize, bool keepContent ) {
-	OG_ASSERT( newSize > 0 );
-	size = static_cast<int>( ceil( static_cast<float>(newSize)/static_cast<float>(granularity) ) ) * granularity;
+	OG_ASSERT( newSize > 0 && newSize >= num );
+	size = newSize;
 
-	T *newList = new T[ size ];
+	T *newList = static_cast<T *>( ::operator new( size * sizeof( T ) ) );
 
 	if ( list ) {
-		if ( keepContent ) {
+		if ( !keepContent ) {
 			for ( int i=0; i<num; i++ )
-				newList[i] = list[i];
-		}
-		else
+				list[i].~T();
 			num = 0;
-		delete[] list;
+		} else if ( IsRelocatable<T>::value ) {
+			memcpy( static_cast<void *>( newList ), list, num * sizeof( T ) );
+		} else {
+			for ( int i=0; i<num; i++ ) {
+				new( newList + i ) T( list[i] );
+				list[i].~T();
+			}
+		}
+		::operator delete( list );
 	}
 	list = newList;
 }
@@ -392,6 +590,7 @@ template<class T>
 OG_INLINE ListEx<T>::ListEx( int _granularity ) {
 	list		= OG_NULL;
 	granularity = _granularity;
+	geometric	= false;
 	Clear();
 }
 
@@ -404,6 +603,7 @@ template<class T>
 OG_INLINE ListEx<T>::ListEx( const ListEx<T> &other ) {
 	list = OG_NULL;
 	granularity = other.granularity;
+	geometric = other.geometric;
 	Copy(other);
 }
 
@@ -488,6 +688,16 @@ OG_INLINE int ListEx<T>::GetGranularity( void ) const {
 	return granularity;
 }
 
+/*
+================
+ListEx::SetGeometricGrowth
+================
+*/
+template<class T>
+OG_INLINE void ListEx<T>::SetGeometricGrowth( bool enable ) {
+	geometric = enable;
+}
+
 /*
 ================
 ListEx::operator[]
@@ -525,8 +735,9 @@ copy all items from the other list.
 template<class T>
 void ListEx<T>::Copy( const ListEx<T> &other ) {
 	Clear();
+	Reserve( other.num );
 	for( int i=0; i<other.num; i++ )
-		Alloc() = other[i];
+		list[num++] = new T( other[i] );
 }
 
 /*
@@ -538,10 +749,8 @@ Synonym for Copy
 */
 template<class T>
 ListEx<T> &ListEx<T>::operator=( const ListEx<T> &other ) {
-	Clear();
-	for( int i=0; i<other.num; i++ )
-		Alloc() = other[i];
-
+	if ( &other != this )
+		Copy( other );
 	return *this;
 }
 
@@ -555,7 +764,31 @@ Calls Resize if needed
 template<class T>
 OG_INLINE void ListEx<T>::CheckSize( int newSize, bool keepContent ) {
 	if ( newSize > size )
-		Resize( newSize, keepContent );
+		Resize( GetGrowSize( newSize ), keepContent );
+}
+
+/*
+================
+ListEx::Reserve
+================
+*/
+template<class T>
+void ListEx<T>::Reserve( int count ) {
+	if ( count > size )
+		Resize( count, true );
+}
+
+/*
+================
+ListEx::ShrinkToFit
+================
+*/
+template<class T>
+void ListEx<T>::ShrinkToFit( void ) {
+	if ( num == 0 )
+		Clear();
+	else if ( num < size )
+		Resize( num, true );
 }
 
 /*
@@ -573,6 +806,39 @@ T& ListEx<T>::Alloc( void ) {
 	return *list[num++];
 }
 
+/*
+================
+ListEx::EmplaceBack
+================
+*/
+template<class T>
+OG_INLINE T& ListEx<T>::EmplaceBack( void ) {
+	CheckSize( num+1 );
+	list[num] = new T();
+	return *list[num++];
+}
+template<class T>
+template<class A1>
+OG_INLINE T& ListEx<T>::EmplaceBack( const A1 &a1 ) {
+	CheckSize( num+1 );
+	list[num] = new T( a1 );
+	return *list[num++];
+}
+template<class T>
+template<class A1, class A2>
+OG_INLINE T& ListEx<T>::EmplaceBack( const A1 &a1, const A2 &a2 ) {
+	CheckSize( num+1 );
+	list[num] = new T( a1, a2 );
+	return *list[num++];
+}
+template<class T>
+template<class A1, class A2, class A3>
+OG_INLINE T& ListEx<T>::EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 ) {
+	CheckSize( num+1 );
+	list[num] = new T( a1, a2, a3 );
+	return *list[num++];
+}
+
 /*
 ================
 ListEx::EnsureAllocated
@@ -593,7 +859,7 @@ ListEx::Append
 */
 template<class T>
 OG_INLINE void ListEx<T>::Append( const T &value ) {
-	Alloc() = value;
+	EmplaceBack( value );
 }
 
 /*
@@ -610,11 +876,24 @@ void ListEx<T>::Remove( int index ) {
 	OG_ASSERT( index >= 0 && index < num );
 
 	delete list[index];
-	for ( int i=index; i<num; i++ ) {
-		if ( (i+1) < num )
-			list[i] = list[i+1];
-	}
-	list[--num] = OG_NULL;
+	num--;
+	memmove( list + index, list + index + 1, (num - index) * sizeof( T * ) );
+	list[num] = OG_NULL;
+}
+
+/*
+================
+ListEx::RemoveFast
+================
+*/
+template<class T>
+void ListEx<T>::RemoveFast( int index ) {
+	OG_ASSERT( index >= 0 && index < num );
+
+	delete list[index];
+	num--;
+	list[index] = list[num];
+	list[num] = OG_NULL;
 }
 
 /*
@@ -706,12 +985,28 @@ int ListEx<T>::CompareCallbackEx( void *context, const void *a, const void *b )
 	return cmpData->func( *pa, *pb, cmpData->param );
 }
 
+/*
+================
+ListEx::GetGrowSize
+
+Round up to the granularity,
+and grow by at least the current size
+if geometric growth is enabled.
+================
+*/
+template<class T>
+int ListEx<T>::GetGrowSize( int newSize ) const {
+	int count = ( ( newSize + granularity - 1 ) / granularity ) * granularity;
+	if ( geometric && count < size * 2 )
+		count = size * 2;
+	return count;
+}
+
 /*
 ================
 ListEx::Resize
 
 Create a new list with n item pointers.
-(Checks for granularity)
 Copies all pointer values if wanted.
 Otherwise the old data will be freed
 Old pointer list will be freed.
@@ -719,16 +1014,14 @@ Old pointer list will be freed.
 */
 template<class T>
 void ListEx<T>::Resize( int newSize, bool keepContent ) {
-	OG_ASSERT( newSize > 0 );
-	size = static_cast<int>( ceil( static_cast<float>(newSize)/static_cast<float>(granularity) ) ) * granularity;
+	OG_ASSERT( newSize > 0 && newSize >= num );
+	size = newSize;
 
 	T **newList = new T *[ size ];
 
 	if ( list ) {
-		if ( keepContent ) {
-			for ( int i=0; i<num; i++ )
-				newList[i] = list[i];
-		}
+		if ( keepContent )
+			memcpy( newList, list, num * sizeof( T * ) );
 		else {
 			for ( int i=0; i<num; i++ )
 				delete list[i];
@@ -753,10 +1046,10 @@ StringList::Append
 ================
 */
 OG_INLINE void StringList::Append( const String &value ) {
-	Alloc() = value;
+	EmplaceBack( value );
 }
 OG_INLINE void StringList::Append( const char *value ) {
-	Alloc() = value;
+	EmplaceBack( value );
 }
 OG_INLINE void StringList::Append( const char *value, int byteLen, int len ) {
 	Alloc().SetData( value, byteLen, len );
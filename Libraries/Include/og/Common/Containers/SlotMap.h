@@ -0,0 +1,204 @@
+// ==============================================================================
+//! @file
+//! @brief	Slot Map ( dense storage with generation checked handles )
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_SLOTMAP_H__
+#define __OG_SLOTMAP_H__
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// ==============================================================================
+	//! SlotMap -> use for objects which get handed out and freed in any order
+	//!
+	//! All items are stored densely in one list, so iterating is as fast as with List.
+	//! Adding and removing is done in constant time: removing moves the last item into the gap.
+	//! Items are referred to by a 32 bit handle, which contains the slot and its generation.
+	//! The generation changes whenever a slot gets freed, so a stale handle is
+	//! detected instead of reaching a different item.
+	//!
+	//! @note	Items get moved around, so do not keep pointers to them.
+	//!			Store pointers in the SlotMap if the objects need a fixed address.
+	// ==============================================================================
+	template<class T>
+	class SlotMap {
+	public:
+		static const uInt	INVALID_HANDLE	= 0;	//!< Never returned by Add or Alloc
+
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	granularity	The granularity of the lists
+		// ==============================================================================
+		SlotMap( int granularity = 16 );
+
+		// ==============================================================================
+		//! Remove all items
+		//!
+		//! @note	All handles become invalid, the slots stay allocated.
+		// ==============================================================================
+		void		Clear( void );
+
+		// ==============================================================================
+		//! Check if the map is empty
+		//!
+		//! @return	true if there are no items, otherwise false
+		// ==============================================================================
+		bool		IsEmpty( void ) const;
+
+		// ==============================================================================
+		//! Get the number of items
+		//!
+		//! @return	The number of items
+		// ==============================================================================
+		int			Num( void ) const;
+
+		// ==============================================================================
+		//! Make sure the specified number of items fit without resizing
+		//!
+		//! @param	count	The number of items
+		// ==============================================================================
+		void		Reserve( int count );
+
+		// ==============================================================================
+		//! Add a default constructed item
+		//!
+		//! @param	handle	Receives the handle of the new item
+		//!
+		//! @return	Reference to the new item
+		// ==============================================================================
+		T &			Alloc( uInt &handle );
+
+		// ==============================================================================
+		//! Add a copy of an item
+		//!
+		//! @param	value	The item to add
+		//!
+		//! @return	The handle of the new item
+		// ==============================================================================
+		uInt		Add( const T &value );
+
+		// ==============================================================================
+		//! Remove an item
+		//!
+		//! @param	handle	The handle of the item
+		//!
+		//! @return	false if the handle was stale, otherwise true
+		//!
+		//! @note	The last item gets moved into its place, so dense indices change.
+		// ==============================================================================
+		bool		Remove( uInt handle );
+
+		// ==============================================================================
+		//! Check if a handle still refers to an item
+		//!
+		//! @param	handle	The handle to check
+		//!
+		//! @return	true if the item exists, otherwise false
+		// ==============================================================================
+		bool		IsValid( uInt handle ) const;
+
+		// ==============================================================================
+		//! Get an item by its handle
+		//!
+		//! @param	handle	The handle of the item
+		//!
+		//! @return	OG_NULL if the handle is stale, otherwise a pointer to the item
+		// ==============================================================================
+		T *			Get( uInt handle );
+		const T *	Get( uInt handle ) const;
+
+		// ==============================================================================
+		//! Get the dense index of an item
+		//!
+		//! @param	handle	The handle of the item
+		//!
+		//! @return	-1 if the handle is stale, otherwise the index for operator[]
+		// ==============================================================================
+		int			GetIndex( uInt handle ) const;
+
+		// ==============================================================================
+		//! Get the handle of an item
+		//!
+		//! @param	index	The dense index of the item
+		//!
+		//! @return	The handle of the item
+		// ==============================================================================
+		uInt		GetHandle( int index ) const;
+
+		// ==============================================================================
+		//! Access an item by its dense index
+		//!
+		//! @param	index	The index ( 0 to Num()-1 )
+		//!
+		//! @return	Reference to the item
+		// ==============================================================================
+		const T &	operator[]( int index ) const;
+		T &			operator[]( int index );
+
+	private:
+		static const int	INDEX_BITS		= 20;						//!< Bits of the handle used for the slot
+		static const uInt	INDEX_MASK		= (1 << INDEX_BITS) - 1;	//!< Mask for the slot
+		static const uInt	MAX_GENERATION	= 0xFFF;					//!< The remaining bits store the generation
+
+		// ==============================================================================
+		//! Get a slot for a new item
+		//!
+		//! @return	The slot index
+		// ==============================================================================
+		int			AllocSlot( void );
+
+		// ==============================================================================
+		//! Free a slot and invalidate all its handles
+		//!
+		//! @param	slot	The slot index
+		// ==============================================================================
+		void		FreeSlot( int slot );
+
+		// ==============================================================================
+		//! Find the slot a handle refers to
+		//!
+		//! @param	handle	The handle
+		//!
+		//! @return	-1 if the handle is stale, otherwise the slot index
+		// ==============================================================================
+		int			FindSlot( uInt handle ) const;
+
+		List<T>		items;			//!< The items, densely packed
+		List<int>	itemSlots;		//!< The slot of each item
+		List<int>	slotIndices;	//!< Index of the item in a used slot, the next free slot otherwise
+		List<uShort> slotGenerations;	//!< The current generation of each slot
+		int			freeHead;		//!< The first free slot, -1 if none
+		int			freeTail;		//!< The last free slot, -1 if none
+	};
+//! @}
+}
+
+#endif
@@ -0,0 +1,283 @@
+/*
+===========================================================================
+The Open Game Libraries.
+Copyright (C) 2007-2010 Lusito Software
+
+Author:  Santo Pfingsten (TTK-Bandit)
+Purpose: Slot Map ( dense storage with generation checked handles )
+-----------------------------------------
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+===========================================================================
+*/
+
+#ifndef __OG_SLOTMAP_INL__
+#define __OG_SLOTMAP_INL__
+
+namespace og {
+
+/*
+==============================================================================
+
+  SlotMap
+
+==============================================================================
+*/
+
+/*
+================
+SlotMap::SlotMap
+================
+*/
+template<class T>
+OG_INLINE SlotMap<T>::SlotMap( int granularity )
+	: items(granularity), itemSlots(granularity), slotIndices(granularity), slotGenerations(granularity) {
+	items.SetGeometricGrowth( true );
+	itemSlots.SetGeometricGrowth( true );
+	slotIndices.SetGeometricGrowth( true );
+	slotGenerations.SetGeometricGrowth( true );
+	freeHead = -1;
+	freeTail = -1;
+}
+
+/*
+================
+SlotMap::Clear
+================
+*/
+template<class T>
+void SlotMap<T>::Clear( void ) {
+	int num = itemSlots.Num();
+	for( int i=0; i<num; i++ )
+		FreeSlot( itemSlots[i] );
+	items.Clear();
+	itemSlots.Clear();
+}
+
+/*
+================
+SlotMap::IsEmpty
+================
+*/
+template<class T>
+OG_INLINE bool SlotMap<T>::IsEmpty( void ) const {
+	return items.IsEmpty();
+}
+
+/*
+================
+SlotMap::Num
+================
+*/
+template<class T>
+OG_INLINE int SlotMap<T>::Num( void ) const {
+	return items.Num();
+}
+
+/*
+================
+SlotMap::Reserve
+================
+*/
+template<class T>
+void SlotMap<T>::Reserve( int count ) {
+	items.Reserve( count );
+	itemSlots.Reserve( count );
+	slotIndices.Reserve( count );
+	slotGenerations.Reserve( count );
+}
+
+/*
+================
+SlotMap::Alloc
+================
+*/
+template<class T>
+T &SlotMap<T>::Alloc( uInt &handle ) {
+	int slot = AllocSlot();
+	handle = (static_cast<uInt>(slotGenerations[slot]) << INDEX_BITS) | slot;
+	itemSlots.Append( slot );
+	return items.EmplaceBack();
+}
+
+/*
+================
+SlotMap::Add
+================
+*/
+template<class T>
+uInt SlotMap<T>::Add( const T &value ) {
+	int slot = AllocSlot();
+	itemSlots.Append( slot );
+	items.Append( value );
+	return (static_cast<uInt>(slotGenerations[slot]) << INDEX_BITS) | slot;
+}
+
+/*
+================
+SlotMap::Remove
+================
+*/
+template<class T>
+bool SlotMap<T>::Remove( uInt handle ) {
+	int slot = FindSlot( handle );
+	if ( slot == -1 )
+		return false;
+
+	int index = slotIndices[slot];
+	int last = items.Num() - 1;
+	items.RemoveFast( index );
+	itemSlots.RemoveFast( index );
+	if ( index != last )
+		slotIndices[itemSlots[index]] = index;
+
+	FreeSlot( slot );
+	return true;
+}
+
+/*
+================
+SlotMap::IsValid
+================
+*/
+template<class T>
+OG_INLINE bool SlotMap<T>::IsValid( uInt handle ) const {
+	return FindSlot( handle ) != -1;
+}
+
+/*
+================
+SlotMap::Get
+================
+*/
+template<class T>
+OG_INLINE T *SlotMap<T>::Get( uInt handle ) {
+	int slot = FindSlot( handle );
+	return slot == -1 ? OG_NULL : &items[slotIndices[slot]];
+}
+template<class T>
+OG_INLINE const T *SlotMap<T>::Get( uInt handle ) const {
+	int slot = FindSlot( handle );
+	return slot == -1 ? OG_NULL : &items[slotIndices[slot]];
+}
+
+/*
+================
+SlotMap::GetIndex
+================
+*/
+template<class T>
+OG_INLINE int SlotMap<T>::GetIndex( uInt handle ) const {
+	int slot = FindSlot( handle );
+	return slot == -1 ? -1 : slotIndices[slot];
+}
+
+/*
+================
+SlotMap::GetHandle
+================
+*/
+template<class T>
+OG_INLINE uInt SlotMap<T>::GetHandle( int index ) const {
+	int slot = itemSlots[index];
+	return (static_cast<uInt>(slotGenerations[slot]) << INDEX_BITS) | slot;
+}
+
+/*
+================
+SlotMap::operator[]
+================
+*/
+template<class T>
+OG_INLINE const T &SlotMap<T>::operator[]( int index ) const {
+	return items[index];
+}
+template<class T>
+OG_INLINE T &SlotMap<T>::operator[]( int index ) {
+	return items[index];
+}
+
+/*
+================
+SlotMap::AllocSlot
+
+Free slots are reused in the order they were freed,
+so a generation takes as long as possible to come around again.
+================
+*/
+template<class T>
+int SlotMap<T>::AllocSlot( void ) {
+	int slot;
+	if ( freeHead != -1 ) {
+		slot = freeHead;
+		if ( freeHead == freeTail )
+			freeHead = freeTail = -1;
+		else
+			freeHead = slotIndices[slot];
+	} else {
+		slot = slotIndices.Num();
+		OG_ASSERT( static_cast<uInt>(slot) <= INDEX_MASK );
+		slotIndices.Append( 0 );
+		slotGenerations.Append( 1 );
+	}
+	slotIndices[slot] = items.Num();
+	return slot;
+}
+
+/*
+================
+SlotMap::FreeSlot
+================
+*/
+template<class T>
+void SlotMap<T>::FreeSlot( int slot ) {
+	// Generation 0 is skipped, so INVALID_HANDLE never matches
+	uShort &generation = slotGenerations[slot];
+	generation = ( generation == MAX_GENERATION ) ? 1 : generation + 1;
+
+	slotIndices[slot] = -1;
+	if ( freeTail == -1 )
+		freeHead = slot;
+	else
+		slotIndices[freeTail] = slot;
+	freeTail = slot;
+}
+
+/*
+================
+SlotMap::FindSlot
+================
+*/
+template<class T>
+OG_INLINE int SlotMap<T>::FindSlot( uInt handle ) const {
+	int slot = static_cast<int>( handle & INDEX_MASK );
+	if ( slot >= slotIndices.Num() || slotGenerations[slot] != (handle >> INDEX_BITS) )
+		return -1;
+
+	// A very old handle might match again once the generation wrapped around,
+	// make sure it doesn't point to a free slot at least.
+	int index = slotIndices[slot];
+	if ( index < 0 || index >= items.Num() || itemSlots[index] != slot )
+		return -1;
+	return slot;
+}
+
+}
+
+#endif
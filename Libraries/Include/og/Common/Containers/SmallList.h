@@ -0,0 +1,341 @@
+// ==============================================================================
+//! @file
+//! @brief	Small List ( inline storage for the first items )
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_SMALLLIST_H__
+#define __OG_SMALLLIST_H__
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// ==============================================================================
+	//! SmallList -> use for short lived lists, which usually hold just a few items
+	//!
+	//! The first N items are stored within the object itself, so no dynamic memory
+	//! is needed until the list grows beyond that. The interface matches List.
+	//!
+	//! @note	Relocatable items ( see IsRelocatable ) are moved with memcpy,
+	//!			all others get copy constructed.
+	// ==============================================================================
+	template<class T, int N>
+	class SmallList {
+	public:
+		// ==============================================================================
+		//! Constructor
+		// ==============================================================================
+		SmallList();
+
+		// ==============================================================================
+		//! Copy Constructor
+		//!
+		//! @param	other	The list to copy from
+		// ==============================================================================
+		SmallList( const SmallList<T, N> &other );
+
+		// ==============================================================================
+		//! Virtual Destructor
+		// ==============================================================================
+		virtual ~SmallList();
+
+		// ==============================================================================
+		//! Definition for a comparision function without extra parameters
+		// ==============================================================================
+		typedef int ( *cmpFunc_t )( const T &a, const T &b );
+
+		// ==============================================================================
+		//! Definition for a comparision function with extra parameters
+		// ==============================================================================
+		typedef int ( *cmpFuncEx_t )( const T &a, const T &b, void *param );
+
+		// ==============================================================================
+		//! Clear all entries and free the dynamic memory
+		// ==============================================================================
+		void		Clear( void );
+
+		// ==============================================================================
+		//! Checks to see if list is empty
+		//!
+		//! @return	true if empty, false if not
+		// ==============================================================================
+		bool		IsEmpty( void ) const;
+
+		// ==============================================================================
+		//! Get the number of entries
+		//!
+		//! @return	The current number of entries
+		// ==============================================================================
+		int			Num( void ) const;
+
+		// ==============================================================================
+		//! Get the number of allocated items
+		//!
+		//! @return	The current number of allocated items
+		// ==============================================================================
+		int			AllocSize( void ) const;
+
+		// ==============================================================================
+		//! Check if the items are still stored inline
+		//!
+		//! @return	true if no dynamic memory is used
+		// ==============================================================================
+		bool		IsInline( void ) const;
+
+		// ==============================================================================
+		//! Get the next unused item, resize the list if needed
+		//!
+		//! @return	a reference to the new object
+		// ==============================================================================
+		T &			Alloc( void );
+
+		// ==============================================================================
+		//! Make sure there is room for n items, without changing the number of entries
+		//!
+		//! @param	count	The number of items to make room for
+		// ==============================================================================
+		void		Reserve( int count );
+
+		// ==============================================================================
+		//! Construct a new item in place, resize the list if needed
+		//!
+		//! @param	a1, a2, a3	The constructor arguments
+		//!
+		//! @return	a reference to the new object
+		//!
+		//! @note	The arguments must not reference items of this list
+		// ==============================================================================
+		T &			EmplaceBack( void );
+		template<class A1>
+		T &			EmplaceBack( const A1 &a1 );
+		template<class A1, class A2>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2 );
+		template<class A1, class A2, class A3>
+		T &			EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 );
+
+		// ==============================================================================
+		//! Add a new item, resize the list if needed
+		//!
+		//! @param	value	The value to append
+		// ==============================================================================
+		void		Append( const T &value );
+
+		// ==============================================================================
+		//! Remove an item (list won't be resized)
+		//!
+		//! @param	index	The index to remove
+		// ==============================================================================
+		void		Remove( int index );
+
+		// ==============================================================================
+		//! Remove an item by moving the last item into its place (list won't be resized)
+		//!
+		//! @param	index	The index to remove
+		//!
+		//! @note	Faster than Remove, but the order of the items is not kept
+		// ==============================================================================
+		void		RemoveFast( int index );
+
+		// ==============================================================================
+		//! Copy data from an existing list
+		//!
+		//! @param	other	The list to copy from
+		// ==============================================================================
+		void		Copy( const SmallList<T, N> &other );
+
+		// ==============================================================================
+		//! Find an item in the list
+		//!
+		//! @param	value	The value to look for
+		//!
+		//! @return	the index of the first matching item
+		// ==============================================================================
+		int			Find( const T &value ) const;
+
+		// ==============================================================================
+		//! Sort the list and (optional) remove duplicates
+		//!
+		//! @param	compare		The comparision function
+		//! @param	removeDupes	true to remove duplicates
+		// ==============================================================================
+		void		Sort( cmpFunc_t compare, bool removeDupes );
+
+		// ==============================================================================
+		//! Sort the list by specifying a parameter and (optional) remove duplicates
+		//!
+		//! @param	compare		The comparision function
+		//! @param	param		The parameter to pass to the comparision function
+		//! @param	removeDupes	true to remove duplicates
+		// ==============================================================================
+		void		SortEx( cmpFuncEx_t compare, void *param, bool removeDupes );
+
+	// operators
+		// ==============================================================================
+		//! Copy all entries from the other list
+		//!
+		//! @param	other	The other list
+		//!
+		//! @return	A reference to this object
+		// ==============================================================================
+		SmallList<T, N> &	operator=( const SmallList<T, N> &other );
+
+		// ==============================================================================
+		//! Add a new item, resize the list if needed
+		//!
+		//! @param	value	The value to append
+		// ==============================================================================
+		void		operator+=( const T &value );
+
+		// ==============================================================================
+		//! Get a value by its index
+		//!
+		//! @param	index	Zero-based index
+		//!
+		//! @return	A reference to the object
+		// ==============================================================================
+		const T &	operator[]( int index ) const;
+		T &			operator[]( int index );
+
+	protected:
+		int			num;			//!< Number of used items
+		int			size;			//!< Total number of items
+		T *			list;			//!< Pointer to the items ( inline or dynamic )
+
+		// ==============================================================================
+		//! Storage for the first N items, aligned for any basic type
+		// ==============================================================================
+		union {
+			char		data[N * sizeof( T )];
+			double		alignDouble;
+			long long	alignLongLong;
+			void *		alignPointer;
+		} inlineItems;
+
+		// ==============================================================================
+		//! Get the inline storage
+		//!
+		//! @return	Pointer to the first inline item
+		// ==============================================================================
+		T *			GetInlineItems( void );
+
+		// ==============================================================================
+		//! Move all items into dynamic memory of the specified size
+		//!
+		//! @param	newSize		The new list size
+		// ==============================================================================
+		void		Resize( int newSize );
+
+		// ==============================================================================
+		//! Sort the items by a list of their indices
+		//!
+		//! @param	order	The indices in the new order
+		// ==============================================================================
+		void		Reorder( SmallList<int, N> &order );
+
+		// ==============================================================================
+		//! Comparison callback
+		//!
+		//! @param	context	A pointer to the CompareData object
+		//! @param	a		A pointer to the first index
+		//! @param	b		A pointer to the second index
+		//!
+		//! @return	0 if the objects match, otherwise positive or negative
+		// ==============================================================================
+		static int	CompareCallback( void *context, const void *a, const void *b );
+
+		// ==============================================================================
+		//! Comparison callback
+		//!
+		//! @param	context	A pointer to the CompareDataEx object
+		//! @param	a		A pointer to the first index
+		//! @param	b		A pointer to the second index
+		//!
+		//! @return	0 if the objects match, otherwise positive or negative
+		// ==============================================================================
+		static int	CompareCallbackEx( void *context, const void *a, const void *b );
+
+		// ==============================================================================
+		//! Comparison data
+		// ==============================================================================
+		class CompareData {
+		public:
+			CompareData( cmpFunc_t f, const T *i ) : func(f), items(i) {}
+
+			cmpFunc_t	func;		//!< The normal comparison function
+			const T *	items;		//!< The items to compare
+		};
+
+		// ==============================================================================
+		//! Comparison data with parameter
+		// ==============================================================================
+		class CompareDataEx {
+		public:
+			CompareDataEx( cmpFuncEx_t f, void *p, const T *i ) : func(f), param(p), items(i) {}
+
+			cmpFuncEx_t	func;		//!< The extended comparison function
+			void		*param;		//!< The parameter ( for the extended comparison )
+			const T *	items;		//!< The items to compare
+		};
+	};
+
+	// ==============================================================================
+	//! SmallStringList -> adding the StringList functions to SmallList
+	// ==============================================================================
+	template<int N>
+	class SmallStringList : public SmallList<String, N> {
+	public:
+		// ==============================================================================
+		//! Add a new string, resize the list if needed
+		//!
+		//! @param	value	The value
+		// ==============================================================================
+		void		Append( const String &value );
+		void		Append( const char *value );
+
+		// ==============================================================================
+		//! Find an item in the list
+		//!
+		//! @param	value	The value to look for
+		//!
+		//! @return	the index of the first matching item
+		// ==============================================================================
+		int			Find( const char *value ) const;
+		int			IFind( const char *value ) const;
+
+	// operators
+		// ==============================================================================
+		//! Add a new item, resize the list if needed
+		//!
+		//! @param	value	The value to append
+		// ==============================================================================
+		void		operator+=( const char *value );
+	};
+//! @}
+}
+
+#endif
@@ -0,0 +1,541 @@
+/*
+===========================================================================
+The Open Game Libraries.
+Copyright (C) 2007-2010 Lusito Software
+
+Author:  Santo Pfingsten (TTK-Bandit)
+Purpose: Small List ( inline storage for the first items )
+-----------------------------------------
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+===========================================================================
+*/
+
+#ifndef __OG_SMALLLIST_INL__
+#define __OG_SMALLLIST_INL__
+
+namespace og {
+
+/*
+==============================================================================
+
+  SmallList
+
+==============================================================================
+*/
+
+/*
+================
+SmallList::SmallList
+================
+*/
+template<class T, int N>
+OG_INLINE SmallList<T, N>::SmallList() {
+	num		= 0;
+	size	= N;
+	list	= GetInlineItems();
+}
+
+/*
+================
+SmallList::SmallList
+================
+*/
+template<class T, int N>
+OG_INLINE SmallList<T, N>::SmallList( const SmallList<T, N> &other ) {
+	num		= 0;
+	size	= N;
+	list	= GetInlineItems();
+	Copy( other );
+}
+
+/*
+================
+SmallList::~SmallList
+================
+*/
+template<class T, int N>
+OG_INLINE SmallList<T, N>::~SmallList() {
+	Clear();
+}
+
+/*
+================
+SmallList::Clear
+
+Destroys all items and
+returns to the inline storage.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Clear( void ) {
+	for ( int i=0; i<num; i++ )
+		list[i].~T();
+	if ( !IsInline() ) {
+		::operator delete( list );
+		list = GetInlineItems();
+		size = N;
+	}
+	num = 0;
+}
+
+/*
+================
+SmallList::IsEmpty
+================
+*/
+template<class T, int N>
+OG_INLINE bool SmallList<T, N>::IsEmpty( void ) const {
+	return num == 0;
+}
+
+/*
+================
+SmallList::Num
+================
+*/
+template<class T, int N>
+OG_INLINE int SmallList<T, N>::Num( void ) const {
+	return num;
+}
+
+/*
+================
+SmallList::AllocSize
+================
+*/
+template<class T, int N>
+OG_INLINE int SmallList<T, N>::AllocSize( void ) const {
+	return size;
+}
+
+/*
+================
+SmallList::IsInline
+================
+*/
+template<class T, int N>
+OG_INLINE bool SmallList<T, N>::IsInline( void ) const {
+	return list == reinterpret_cast<const T *>( inlineItems.data );
+}
+
+/*
+================
+SmallList::GetInlineItems
+================
+*/
+template<class T, int N>
+OG_INLINE T *SmallList<T, N>::GetInlineItems( void ) {
+	return reinterpret_cast<T *>( inlineItems.data );
+}
+
+/*
+================
+SmallList::operator[]
+================
+*/
+template<class T, int N>
+OG_INLINE const T &SmallList<T, N>::operator[]( int index ) const {
+	OG_ASSERT( index >= 0 && index < num );
+	return list[index];
+}
+template<class T, int N>
+OG_INLINE T &SmallList<T, N>::operator[]( int index ) {
+	OG_ASSERT( index >= 0 && index < num );
+	return list[index];
+}
+
+/*
+================
+SmallList::operator+=
+================
+*/
+template<class T, int N>
+OG_INLINE void SmallList<T, N>::operator+=( const T &value ) {
+	Append( value );
+}
+
+/*
+================
+SmallList::Copy
+
+Clear the list and
+copy all items from the other list.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Copy( const SmallList<T, N> &other ) {
+	Clear();
+	Reserve( other.num );
+	for( int i=0; i<other.num; i++ )
+		new( list + i ) T( other.list[i] );
+	num = other.num;
+}
+
+/*
+================
+SmallList::operator=
+
+Synonym for Copy
+================
+*/
+template<class T, int N>
+OG_INLINE SmallList<T, N> &SmallList<T, N>::operator=( const SmallList<T, N> &other ) {
+	if ( &other != this )
+		Copy( other );
+	return *this;
+}
+
+/*
+================
+SmallList::Reserve
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Reserve( int count ) {
+	if ( count > size )
+		Resize( count );
+}
+
+/*
+================
+SmallList::Alloc
+
+Returns the first free item
+in the list and resizes if needed.
+================
+*/
+template<class T, int N>
+T &SmallList<T, N>::Alloc( void ) {
+	if ( num == size )
+		Resize( size * 2 );
+	new( list + num ) T;
+	return list[num++];
+}
+
+/*
+================
+SmallList::EmplaceBack
+================
+*/
+template<class T, int N>
+OG_INLINE T &SmallList<T, N>::EmplaceBack( void ) {
+	if ( num == size )
+		Resize( size * 2 );
+	new( list + num ) T();
+	return list[num++];
+}
+template<class T, int N>
+template<class A1>
+OG_INLINE T &SmallList<T, N>::EmplaceBack( const A1 &a1 ) {
+	if ( num == size )
+		Resize( size * 2 );
+	new( list + num ) T( a1 );
+	return list[num++];
+}
+template<class T, int N>
+template<class A1, class A2>
+OG_INLINE T &SmallList<T, N>::EmplaceBack( const A1 &a1, const A2 &a2 ) {
+	if ( num == size )
+		Resize( size * 2 );
+	new( list + num ) T( a1, a2 );
+	return list[num++];
+}
+template<class T, int N>
+template<class A1, class A2, class A3>
+OG_INLINE T &SmallList<T, N>::EmplaceBack( const A1 &a1, const A2 &a2, const A3 &a3 ) {
+	if ( num == size )
+		Resize( size * 2 );
+	new( list + num ) T( a1, a2, a3 );
+	return list[num++];
+}
+
+/*
+================
+SmallList::Append
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Append( const T &value ) {
+	if ( num == size ) {
+		// value might be an item of this list
+		T copy( value );
+		Resize( size * 2 );
+		new( list + num ) T( copy );
+	} else
+		new( list + num ) T( value );
+	num++;
+}
+
+/*
+================
+SmallList::Remove
+
+Removes items from the list.
+The list size won't shrink.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Remove( int index ) {
+	OG_ASSERT( index >= 0 && index < num );
+
+	num--;
+	if ( IsRelocatable<T>::value ) {
+		list[index].~T();
+		memmove( static_cast<void *>( list + index ), list + index + 1, (num - index) * sizeof( T ) );
+	} else {
+		for ( int i=index; i<num; i++ )
+			list[i] = list[i+1];
+		list[num].~T();
+	}
+}
+
+/*
+================
+SmallList::RemoveFast
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::RemoveFast( int index ) {
+	OG_ASSERT( index >= 0 && index < num );
+
+	num--;
+	if ( index != num )
+		list[index] = list[num];
+	list[num].~T();
+}
+
+/*
+================
+SmallList::Find
+
+Returns the index of the searched item.
+-1 if no item with this value was found.
+================
+*/
+template<class T, int N>
+int SmallList<T, N>::Find( const T &value ) const {
+	for ( int i=0; i<num; i++ ) {
+		if ( list[i] == value )
+			return i;
+	}
+	return -1;
+}
+
+/*
+================
+SmallList::Sort
+
+Sorts the list and removes duplicates.
+QuickSort works on bytes, so the indices
+get sorted and the items moved afterwards.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Sort( cmpFunc_t compare, bool removeDupes ) {
+	if ( num < 2 )
+		return;
+
+	SmallList<int, N> order;
+	order.Reserve( num );
+	for ( int i=0; i<num; i++ )
+		order.Append( i );
+
+	CompareData cmpData( compare, list );
+	QuickSort( &order[0], num, sizeof( int ), &cmpData, CompareCallback );
+	Reorder( order );
+
+	if ( removeDupes ) {
+		for ( int i=num-2; i>=0; i-- ) {
+			if ( compare( list[i], list[i+1] ) == 0 )
+				Remove(i+1);
+		}
+	}
+}
+
+/*
+================
+SmallList::SortEx
+
+Sorts the list and removes duplicates.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::SortEx( cmpFuncEx_t compare, void *param, bool removeDupes ) {
+	if ( num < 2 )
+		return;
+
+	SmallList<int, N> order;
+	order.Reserve( num );
+	for ( int i=0; i<num; i++ )
+		order.Append( i );
+
+	CompareDataEx cmpData( compare, param, list );
+	QuickSort( &order[0], num, sizeof( int ), &cmpData, CompareCallbackEx );
+	Reorder( order );
+
+	if ( removeDupes ) {
+		for ( int i=num-2; i>=0; i-- ) {
+			if ( compare( list[i], list[i+1], param ) == 0 )
+				Remove(i+1);
+		}
+	}
+}
+
+/*
+================
+SmallList::Reorder
+
+Follows each cycle of the permutation,
+so every item gets moved just once.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Reorder( SmallList<int, N> &order ) {
+	for ( int start=0; start<num; start++ ) {
+		if ( order[start] == start )
+			continue;
+
+		T temp( list[start] );
+		int i = start;
+		int next = order[i];
+		while ( next != start ) {
+			list[i] = list[next];
+			order[i] = i;
+			i = next;
+			next = order[i];
+		}
+		list[i] = temp;
+		order[i] = i;
+	}
+}
+
+/*
+================
+SmallList::CompareCallback
+================
+*/
+template<class T, int N>
+int SmallList<T, N>::CompareCallback( void *context, const void *a, const void *b ) {
+	CompareData *cmpData = reinterpret_cast<CompareData *>(context);
+	return cmpData->func( cmpData->items[*(const int *)a], cmpData->items[*(const int *)b] );
+}
+
+/*
+================
+SmallList::CompareCallbackEx
+================
+*/
+template<class T, int N>
+int SmallList<T, N>::CompareCallbackEx( void *context, const void *a, const void *b ) {
+	CompareDataEx *cmpData = reinterpret_cast<CompareDataEx *>(context);
+	return cmpData->func( cmpData->items[*(const int *)a], cmpData->items[*(const int *)b], cmpData->param );
+}
+
+/*
+================
+SmallList::Resize
+
+Moves all items into dynamic memory,
+relocatable items just get copied bitwise.
+================
+*/
+template<class T, int N>
+void SmallList<T, N>::Resize( int newSize ) {
+	OG_ASSERT( newSize > num );
+
+	T *newList = static_cast<T *>( ::operator new( newSize * sizeof( T ) ) );
+	if ( IsRelocatable<T>::value )
+		memcpy( static_cast<void *>( newList ), list, num * sizeof( T ) );
+	else {
+		for ( int i=0; i<num; i++ ) {
+			new( newList + i ) T( list[i] );
+			list[i].~T();
+		}
+	}
+	if ( !IsInline() )
+		::operator delete( list );
+
+	list = newList;
+	size = newSize;
+}
+
+/*
+==============================================================================
+
+  SmallStringList
+
+==============================================================================
+*/
+
+/*
+================
+SmallStringList::Append
+================
+*/
+template<int N>
+OG_INLINE void SmallStringList<N>::Append( const String &value ) {
+	SmallList<String, N>::Append( value );
+}
+template<int N>
+OG_INLINE void SmallStringList<N>::Append( const char *value ) {
+	this->EmplaceBack( value );
+}
+
+/*
+================
+SmallStringList::Find
+================
+*/
+template<int N>
+int SmallStringList<N>::Find( const char *value ) const {
+	for ( int i=0; i<this->num; i++ ) {
+		if ( this->list[i].Cmp( value ) == 0 )
+			return i;
+	}
+	return -1;
+}
+
+/*
+================
+SmallStringList::IFind
+================
+*/
+template<int N>
+int SmallStringList<N>::IFind( const char *value ) const {
+	for ( int i=0; i<this->num; i++ ) {
+		if ( this->list[i].Icmp( value ) == 0 )
+			return i;
+	}
+	return -1;
+}
+
+/*
+================
+SmallStringList::operator+=
+================
+*/
+template<int N>
+OG_INLINE void SmallStringList<N>::operator+=( const char *value ) {
+	this->EmplaceBack( value );
+}
+
+}
+
+#endif
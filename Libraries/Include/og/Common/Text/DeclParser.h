@@ -70,7 +70,7 @@ namespace og {
 		void			DoInheritance( int index );
 
 		bool *			inheritanceSolved;	//!< Temp var to see what dictionary has already been solved
-		StringList		inheritancePast;	//!< History of all inheritances solved for this dict already,
+		SmallStringList<4> inheritancePast;	//!< History of all inheritances solved for this dict already,
 											//! so we can avoid infinite inheritance
 	};
 
@@ -0,0 +1,244 @@
+// ==============================================================================
+//! @file
+//! @brief	Atomic operations ( compiler intrinsics )
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_ATOMIC_H__
+#define __OG_ATOMIC_H__
+
+#include <og/Setup.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#include <emmintrin.h>
+	#pragma intrinsic( _InterlockedIncrement, _InterlockedDecrement, _InterlockedExchangeAdd )
+	#pragma intrinsic( _InterlockedExchange, _InterlockedCompareExchange )
+	#if defined(_WIN64)
+		#pragma intrinsic( _InterlockedCompareExchangePointer, _InterlockedExchangePointer )
+	#endif
+#endif
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// All functions in here imply a full memory barrier,
+	// except for AtomicLoadAcquire and AtomicStoreRelease.
+
+	// ==============================================================================
+	//! Increment a value atomically
+	//!
+	//! @param	value	Pointer to the value
+	//!
+	//! @return	The incremented value
+	// ==============================================================================
+	OG_INLINE int AtomicIncrement( volatile int *value ) {
+#if defined(_MSC_VER)
+		return _InterlockedIncrement( reinterpret_cast<volatile long *>(value) );
+#else
+		return __sync_add_and_fetch( value, 1 );
+#endif
+	}
+
+	// ==============================================================================
+	//! Decrement a value atomically
+	//!
+	//! @param	value	Pointer to the value
+	//!
+	//! @return	The decremented value
+	// ==============================================================================
+	OG_INLINE int AtomicDecrement( volatile int *value ) {
+#if defined(_MSC_VER)
+		return _InterlockedDecrement( reinterpret_cast<volatile long *>(value) );
+#else
+		return __sync_sub_and_fetch( value, 1 );
+#endif
+	}
+
+	// ==============================================================================
+	//! Add to a value atomically
+	//!
+	//! @param	value	Pointer to the value
+	//! @param	amount	The amount to add ( may be negative )
+	//!
+	//! @return	The new value
+	// ==============================================================================
+	OG_INLINE int AtomicAdd( volatile int *value, int amount ) {
+#if defined(_MSC_VER)
+		return _InterlockedExchangeAdd( reinterpret_cast<volatile long *>(value), amount ) + amount;
+#else
+		return __sync_add_and_fetch( value, amount );
+#endif
+	}
+
+	// ==============================================================================
+	//! Set a value atomically
+	//!
+	//! @param	value		Pointer to the value
+	//! @param	exchange	The new value
+	//!
+	//! @return	The previous value
+	// ==============================================================================
+	OG_INLINE int AtomicExchange( volatile int *value, int exchange ) {
+#if defined(_MSC_VER)
+		return _InterlockedExchange( reinterpret_cast<volatile long *>(value), exchange );
+#else
+		__sync_synchronize();
+		return __sync_lock_test_and_set( value, exchange );
+#endif
+	}
+
+	// ==============================================================================
+	//! Set a value atomically if it matches the comparand
+	//!
+	//! @param	value		Pointer to the value
+	//! @param	exchange	The new value
+	//! @param	comparand	The value to compare with
+	//!
+	//! @return	The previous value, if it equals comparand, the exchange happened
+	// ==============================================================================
+	OG_INLINE int AtomicCompareExchange( volatile int *value, int exchange, int comparand ) {
+#if defined(_MSC_VER)
+		return _InterlockedCompareExchange( reinterpret_cast<volatile long *>(value), exchange, comparand );
+#else
+		return __sync_val_compare_and_swap( value, comparand, exchange );
+#endif
+	}
+
+	// ==============================================================================
+	//! Set a pointer atomically
+	//!
+	//! @param	value		Pointer to the pointer
+	//! @param	exchange	The new pointer
+	//!
+	//! @return	The previous pointer
+	// ==============================================================================
+	template<class T>
+	OG_INLINE T *AtomicExchangePointer( T * volatile *value, T *exchange ) {
+#if defined(_MSC_VER) && defined(_WIN64)
+		return static_cast<T *>( _InterlockedExchangePointer( reinterpret_cast<void * volatile *>(value), exchange ) );
+#elif defined(_MSC_VER)
+		return reinterpret_cast<T *>( _InterlockedExchange( reinterpret_cast<volatile long *>(value), reinterpret_cast<long>(exchange) ) );
+#else
+		__sync_synchronize();
+		return __sync_lock_test_and_set( value, exchange );
+#endif
+	}
+
+	// ==============================================================================
+	//! Set a pointer atomically if it matches the comparand
+	//!
+	//! @param	value		Pointer to the pointer
+	//! @param	exchange	The new pointer
+	//! @param	comparand	The pointer to compare with
+	//!
+	//! @return	The previous pointer, if it equals comparand, the exchange happened
+	// ==============================================================================
+	template<class T>
+	OG_INLINE T *AtomicCompareExchangePointer( T * volatile *value, T *exchange, T *comparand ) {
+#if defined(_MSC_VER) && defined(_WIN64)
+		return static_cast<T *>( _InterlockedCompareExchangePointer( reinterpret_cast<void * volatile *>(value), exchange, comparand ) );
+#elif defined(_MSC_VER)
+		return reinterpret_cast<T *>( _InterlockedCompareExchange( reinterpret_cast<volatile long *>(value),
+										reinterpret_cast<long>(exchange), reinterpret_cast<long>(comparand) ) );
+#else
+		return __sync_val_compare_and_swap( value, comparand, exchange );
+#endif
+	}
+
+	// ==============================================================================
+	//! Full memory barrier, no loads or stores get moved across it
+	// ==============================================================================
+	OG_INLINE void AtomicFence( void ) {
+#if defined(_MSC_VER)
+		long barrier;
+		_InterlockedExchange( &barrier, 0 );
+#else
+		__sync_synchronize();
+#endif
+	}
+
+	// ==============================================================================
+	//! Read a value with acquire semantics
+	//!
+	//! @param	value	Pointer to the value
+	//!
+	//! @return	The value
+	//!
+	//! @note	Unlike the other functions, this is no full barrier:
+	//!			later loads and stores won't get moved before it, that's all.
+	// ==============================================================================
+	OG_INLINE int AtomicLoadAcquire( const volatile int *value ) {
+		int result = *value;
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#elif defined(__i386__) || defined(__x86_64__)
+		__asm__ __volatile__( "" ::: "memory" );
+#else
+		__sync_synchronize();
+#endif
+		return result;
+	}
+
+	// ==============================================================================
+	//! Write a value with release semantics
+	//!
+	//! @param	value	Pointer to the value
+	//! @param	store	The new value
+	//!
+	//! @note	Unlike the other functions, this is no full barrier:
+	//!			earlier loads and stores won't get moved after it, that's all.
+	// ==============================================================================
+	OG_INLINE void AtomicStoreRelease( volatile int *value, int store ) {
+#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+#elif defined(__i386__) || defined(__x86_64__)
+		__asm__ __volatile__( "" ::: "memory" );
+#else
+		__sync_synchronize();
+#endif
+		*value = store;
+	}
+
+	// ==============================================================================
+	//! Tell the cpu we are in a spin loop ( pause instruction on x86 )
+	//!
+	//! @note	Saves power and frees execution units for the other hyperthread
+	// ==============================================================================
+	OG_INLINE void AtomicPause( void ) {
+#if defined(_MSC_VER)
+		_mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+		__asm__ __volatile__( "pause" );
+#endif
+	}
+
+//! @}
+}
+
+#endif
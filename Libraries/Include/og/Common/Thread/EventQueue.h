@@ -1,6 +1,6 @@
 // ==============================================================================
 //! @file
-//! @brief	Event Queue
+//! @brief	Event Queue and Event Bus
 //! @author	Santo Pfingsten (TTK-Bandit)
 //! @note	Copyright (C) 2007-2010 Lusito Software
 // ==============================================================================
@@ -97,6 +97,226 @@ namespace og {
 	private:
 		LockFreeQueue<QueuedEvent> queue;	//!< The queue
 	};
+
+	// ==============================================================================
+	//! A typed event bus for many producers and one consumer
+	//!
+	//! Events are plain records, copied into ring segments. Every producing thread
+	//! gets its own segment, so producers never fight over a slot. Segments are picked
+	//! by Thread::GetCurrentIndex, so a new thread takes over the segment of one that ended.
+	//! The consumer drains all segments in batches and passes the events to a handler
+	//! object, so there is no heap allocation and no virtual call per event.
+	//! Every event draws a ticket when it gets added and the consumer processes
+	//! them in ticket order, so the order is the same as with a single queue.
+	//!
+	//! @note	If more than MAX_PRODUCERS threads add events at the same time or a segment is full,
+	//!			the event goes to a locked overflow queue instead.
+	// ==============================================================================
+	template<typename type>
+	class EventBus {
+	public:
+		static const int MAX_PRODUCERS = 16;	//!< Maximum number of running threads with an own segment
+
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	segmentSize	The number of events per producer segment ( gets rounded up to a power of two )
+		// ==============================================================================
+		EventBus( int segmentSize=256 ) : nextTicket(0), numOverflow(0), expectedTicket(1), lastSource(OG_NULL) {
+			int capacity = 2;
+			while( capacity < segmentSize )
+				capacity <<= 1;
+			mask = capacity - 1;
+			for( int i=0; i<MAX_PRODUCERS; i++ ) {
+				segments[i].records = OG_NULL;
+				segments[i].head = segments[i].cachedTail = 0;
+				segments[i].tail = segments[i].batchHead = segments[i].readPos = 0;
+			}
+		}
+
+		// ==============================================================================
+		//! Destructor
+		// ==============================================================================
+		~EventBus() {
+			for( int i=0; i<MAX_PRODUCERS; i++ )
+				delete[] segments[i].records;
+		}
+
+		// ==============================================================================
+		//! Adds a new event to the bus ( any thread )
+		//!
+		//! @param	data	The event to copy into the bus
+		// ==============================================================================
+		void	Add( const type &data ) {
+			Segment *seg = FindSegment();
+			if ( seg != OG_NULL ) {
+				int h = seg->head;
+				if ( Distance( seg->cachedTail, h ) > mask )
+					seg->cachedTail = AtomicLoadAcquire( &seg->tail );
+				if ( Distance( seg->cachedTail, h ) <= mask ) {
+					Record &record = seg->records[h & mask];
+					record.ticket = AtomicIncrement( &nextTicket );
+					record.data = data;
+					AtomicStoreRelease( &seg->head, h + 1 );
+					return;
+				}
+			}
+
+			ogst::lock_guard<ogst::mutex> lock(overflowMutex);
+			Record record;
+			record.ticket = AtomicIncrement( &nextTicket );
+			record.data = data;
+			overflow.Push( record );
+			AtomicIncrement( &numOverflow );
+		}
+
+		// ==============================================================================
+		//! Process all events ( consumer thread only )
+		//!
+		//! @param	handler	Called as handler( const type &event ) for every event, in order
+		//!
+		//! @return	The number of processed events
+		//!
+		//! @note	Stops early at an event that has drawn its ticket, but has not been written yet.
+		//!			Its producer is still inside Add(), so wake up the consumer after Add() returns.
+		// ==============================================================================
+		template<class Handler>
+		int		ProcessAll( Handler &handler ) {
+			int numProcessed = 0;
+			for(;;) {
+				// One acquire per segment and batch
+				const int num = MAX_PRODUCERS;
+				for( int i=0; i<num; i++ )
+					segments[i].batchHead = AtomicLoadAcquire( &segments[i].head );
+				if ( numOverflow > 0 ) {
+					ogst::lock_guard<ogst::mutex> lock(overflowMutex);
+					while( !overflow.IsEmpty() ) {
+						pending.Push( overflow.Front() );
+						overflow.Pop();
+					}
+					numOverflow = 0;
+				}
+
+				int batch = 0;
+				for(;;) {
+					Segment *seg = FindTicket( num );
+					if ( seg != OG_NULL ) {
+						handler( static_cast<const type &>( seg->records[seg->readPos & mask].data ) );
+						seg->readPos++;
+					} else if ( !pending.IsEmpty() && pending.Front().ticket == expectedTicket ) {
+						handler( static_cast<const type &>( pending.Front().data ) );
+						pending.Pop();
+					} else {
+						break;
+					}
+					expectedTicket++;
+					batch++;
+				}
+
+				// Hand the slots back to the producers
+				for( int i=0; i<num; i++ ) {
+					if ( segments[i].tail != segments[i].readPos )
+						AtomicStoreRelease( &segments[i].tail, segments[i].readPos );
+				}
+				if ( batch == 0 )
+					return numProcessed;
+				numProcessed += batch;
+			}
+		}
+
+		// ==============================================================================
+		//! Get the approximate number of events waiting to be processed
+		//!
+		//! @return	The number of events, might be outdated as soon as it returns
+		// ==============================================================================
+		int		Num( void ) const { return nextTicket - expectedTicket + 1; }
+
+	private:
+		struct Record {
+			int		ticket;	//!< The global order of this event
+			type	data;	//!< The event
+		};
+
+		struct Segment {
+			// Producer side
+			Record *		records;	//!< The ring buffer, allocated by the first producer
+			volatile int	head;		//!< Next index to write to
+			int				cachedTail;	//!< The producers last view of tail
+			char			pad0[RING_CACHE_LINE];
+			// Consumer side
+			volatile int	tail;		//!< Next index to read from, as seen by the producer
+			int				batchHead;	//!< Snapshot of head for the current batch
+			int				readPos;	//!< Next index to read from
+			char			pad1[RING_CACHE_LINE];
+		};
+
+		// ==============================================================================
+		//! Distance between two indices, safe for wrap arounds
+		// ==============================================================================
+		static int	Distance( int from, int to ) {
+			return static_cast<int>( static_cast<uInt>(to) - static_cast<uInt>(from) );
+		}
+
+		// ==============================================================================
+		//! Find the segment of the calling thread
+		//!
+		//! @return	NULL if the thread index is too high for a segment
+		//!
+		//! @note	Only one running thread has a given index, and it gets handed over
+		//!			with an atomic operation, so the new owner sees the state of the old one.
+		// ==============================================================================
+		Segment *FindSegment( void ) {
+			int index = Thread::GetCurrentIndex();
+			if ( index < 0 || index >= MAX_PRODUCERS )
+				return OG_NULL;
+
+			// The consumer won't look at the records before the first event got published
+			Segment &seg = segments[index];
+			if ( seg.records == OG_NULL )
+				seg.records = new Record[mask + 1];
+			return &seg;
+		}
+
+		// ==============================================================================
+		//! Find the segment holding the next ticket within the current batch
+		//!
+		//! @param	num	The number of segments to look at
+		//!
+		//! @return	NULL if it has not been published yet or is in the overflow queue
+		// ==============================================================================
+		Segment *FindTicket( int num ) {
+			// Most of the time the next event comes from the same producer
+			if ( lastSource != OG_NULL && lastSource->readPos != lastSource->batchHead
+				&& lastSource->records[lastSource->readPos & mask].ticket == expectedTicket )
+				return lastSource;
+			for( int i=0; i<num; i++ ) {
+				Segment *seg = &segments[i];
+				if ( seg->readPos != seg->batchHead && seg->records[seg->readPos & mask].ticket == expectedTicket ) {
+					lastSource = seg;
+					return seg;
+				}
+			}
+			return OG_NULL;
+		}
+
+		Segment			segments[MAX_PRODUCERS];	//!< The producer segments
+		int				mask;						//!< segment capacity - 1
+		char			pad0[RING_CACHE_LINE];
+		volatile int	nextTicket;					//!< The last ticket drawn
+		char			pad1[RING_CACHE_LINE];
+		volatile int	numOverflow;				//!< Number of events in the overflow queue
+		Queue<Record>	overflow;					//!< Events that did not fit into a segment
+		ogst::mutex		overflowMutex;				//!< Protects the overflow queue
+
+		// Consumer only
+		int				expectedTicket;				//!< The next ticket to process
+		Segment *		lastSource;					//!< The segment of the last processed event
+		Queue<Record>	pending;					//!< Overflow events taken over by the consumer
+
+		// Not copyable
+		EventBus( const EventBus &other );
+		EventBus &operator=( const EventBus &other );
+	};
 //! @}
 }
 
@@ -0,0 +1,161 @@
+// ==============================================================================
+//! @file
+//! @brief	Fibers and cooperative jobs
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_FIBER_H__
+#define __OG_FIBER_H__
+
+#include <og/Common/Thread/JobManager.h>
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// ==============================================================================
+	//! A user space execution context with its own stack
+	//!
+	//! A fiber gets entered from a thread and runs until it leaves again,
+	//! the next Enter() continues where it left. It may be entered from
+	//! a different thread than the last time, but never from two at once.
+	// ==============================================================================
+	class Fiber {
+	public:
+		typedef void (*fiberFunc_t)( void *param );	//!< The fiber entry function
+
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	func		The function to run on the fiber, must not return before Leave() has been called
+		//! @param	param		The parameter to pass to func
+		//! @param	stackSize	The stack size in bytes
+		// ==============================================================================
+		Fiber( fiberFunc_t func, void *param, int stackSize );
+
+		// ==============================================================================
+		//! Destructor, the fiber must not be running
+		//!
+		//! @note	Objects still living on the fiber stack won't be destructed
+		// ==============================================================================
+		~Fiber();
+
+		// ==============================================================================
+		//! Find out if the fiber creation succeeded
+		//!
+		//! @return	true if the fiber can be entered
+		// ==============================================================================
+		bool	IsValid( void ) const { return data != OG_NULL; }
+
+		// ==============================================================================
+		//! Switch from the current thread into the fiber
+		//!
+		//! @note	Returns once the fiber calls Leave()
+		//! @note	On Windows the thread gets converted to a fiber on the first call,
+		//!			and back again when an og::Thread ends ( or at exit for the main thread ).
+		// ==============================================================================
+		void	Enter( void );
+
+		// ==============================================================================
+		//! Switch back to the thread that called Enter() ( call from within the fiber only )
+		// ==============================================================================
+		void	Leave( void );
+
+	private:
+		void	*data;	//!< A pointer to the platform specific fiber data
+
+		// Not copyable
+		Fiber( const Fiber &other );
+		Fiber &operator=( const Fiber &other );
+	};
+
+	// ==============================================================================
+	//! A job running on its own fiber, so it can wait without blocking its worker
+	//!
+	//! While the job waits for a counter ( child jobs, file reads done in another job, .. )
+	//! the worker leaves the fiber and executes other jobs. Once the counter reaches zero,
+	//! the job gets queued again and continues on whichever worker picks it up.
+	//!
+	//! @note	The fiber gets created on the first execution and destroyed when Run() returns.
+	//! @note	Don't hold locks or rely on thread local storage across a call to WaitFor().
+	// ==============================================================================
+	class FiberJob : public Job {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	stackSize	The stack size of the fiber in bytes
+		// ==============================================================================
+		FiberJob( int stackSize=64*1024 ) : fiber(OG_NULL), fiberStackSize(stackSize), isFinished(false), result(JOB_DONE) {}
+
+		// ==============================================================================
+		//! Destructor, the job must not be waiting
+		// ==============================================================================
+		~FiberJob() { delete fiber; }
+
+		// ==============================================================================
+		//! Enters the fiber, which runs Run()
+		//!
+		//! @return	The result of Run(), or JOB_SUSPEND if the job is waiting
+		// ==============================================================================
+		JobResult	Execute( void );
+
+	protected:
+		// ==============================================================================
+		//! Executes the job on the fiber, may call WaitFor()
+		//!
+		//! @return	JobResult: What to do next ( JOB_SUSPEND is not allowed here )
+		// ==============================================================================
+		virtual JobResult	Run( void ) = 0;
+
+		// ==============================================================================
+		//! Wait for a counter to reach zero, the worker executes other jobs meanwhile
+		//!
+		//! @param	counter	The counter to wait for
+		//!
+		//! @note	Call from within Run() only
+		// ==============================================================================
+		void	WaitFor( JobCounter &counter );
+
+	private:
+		// ==============================================================================
+		//! The fiber entry function
+		//!
+		//! @param	param	The FiberJob
+		// ==============================================================================
+		static void	FiberMain( void *param );
+
+		Fiber *		fiber;			//!< The fiber, NULL while not started
+		int			fiberStackSize;	//!< The stack size of the fiber
+		bool		isFinished;		//!< Run() has returned
+		JobResult	result;			//!< The return value of Run()
+	};
+
+//! @}
+}
+
+#endif
@@ -32,12 +32,15 @@
 
 #include <og/Common.h>
 #include <og/Common/Thread/LockFreeQueue.h>
+#include <og/Common/Thread/WorkStealingQueue.h>
 
 //! Open Game Libraries
 namespace og {
 //! @defgroup Common Common (Library)
 //! @{
 	class JobManager;
+	class Job;
+	class JobTraceBuffer;
 
 	// ==============================================================================
 	//! Return value of a job
@@ -45,7 +48,98 @@ namespace og {
 	enum JobResult {
 		JOB_DONE,	//!< Nothing happens ( user manually cleans the job )
 		JOB_REPEAT,	//!< Job gets re-added to the end of the job-queue
-		JOB_DELETE	//!< The job object will be deleted
+		JOB_DELETE,	//!< The job object will be deleted
+		JOB_SUSPEND	//!< Job gets executed again once the counter passed to Job::SuspendUntil reaches zero
+	};
+
+	// ==============================================================================
+	//! Priority of a job, every priority has its own queues
+	// ==============================================================================
+	enum JobPriority {
+		JOB_PRIORITY_CRITICAL,		//!< Needed as soon as possible ( the frame is waiting for it )
+		JOB_PRIORITY_FRAME,			//!< Needed before the end of the frame ( default )
+		JOB_PRIORITY_BACKGROUND,	//!< Streaming, prefetching, .. ( not started while the frame is late )
+		JOB_PRIORITY_NUM
+	};
+
+	// ==============================================================================
+	//! Where to place the workers ( see SysInfo::topology )
+	// ==============================================================================
+	enum JobAffinity {
+		JOB_AFFINITY_NONE,		//!< Workers may run on any processor
+		JOB_AFFINITY_LOGICAL,	//!< Every worker gets pinned to one logical processor, physical cores first
+		JOB_AFFINITY_CORE,		//!< Every worker gets pinned to one physical core ( all of its hyperthreads )
+		JOB_AFFINITY_NODE		//!< Workers may run on any processor of their NUMA node, one node gets filled before the next
+	};
+
+	// ==============================================================================
+	//! How idle workers wait for new jobs
+	//!
+	//! An idle worker spins first, then yields its time slice, then goes to sleep.
+	//! Spinning avoids the cost of waking up a sleeping thread, but burns cpu time.
+	// ==============================================================================
+	class JobIdlePolicy {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	spins		The maximum number of spin loop iterations
+		//! @param	yields		The number of time slices to yield before sleeping
+		//! @param	adapt		Adapt the number of spins to the job arrival rate
+		// ==============================================================================
+		JobIdlePolicy( int spins=1000, int yields=4, bool adapt=true ) : maxSpins(spins), numYields(yields), adaptive(adapt) {}
+
+		int		maxSpins;	//!< The maximum number of spin loop iterations
+		int		numYields;	//!< The number of time slices to yield before sleeping
+		bool	adaptive;	//!< Double the spins whenever spinning paid off, halve them whenever the worker had to sleep
+	};
+
+	// ==============================================================================
+	//! Counts unfinished jobs, so they can be waited for or used as a dependency
+	//!
+	//! Every job added with a counter increments it, it gets decremented once the job
+	//! has been executed or canceled. Jobs added with the counter as dependency
+	//! will be queued once the counter reaches zero.
+	//!
+	//! @note	To run a job after A and B, add A and B with the same counter and
+	//!			use that counter as the dependency of the job.
+	// ==============================================================================
+	class JobCounter {
+	public:
+		// ==============================================================================
+		//! Default constructor
+		// ==============================================================================
+		JobCounter() : count(0), lock(0), waiting(OG_NULL) {}
+
+		// ==============================================================================
+		//! Destructor
+		// ==============================================================================
+		~JobCounter() { OG_ASSERT( count == 0 && waiting == OG_NULL ); }
+
+		// ==============================================================================
+		//! Get the number of unfinished jobs
+		//!
+		//! @return	The number of unfinished jobs
+		// ==============================================================================
+		int		GetCount( void ) const { return count; }
+
+		// ==============================================================================
+		//! Find out if all jobs of this counter are finished
+		//!
+		//! @return	true if done, false if not
+		// ==============================================================================
+		bool	IsDone( void ) const { return count == 0 && lock == 0; }
+
+	private:
+		friend class JobManager;
+
+		volatile int	count;		//!< Number of unfinished jobs
+		volatile int	lock;		//!< Spinlock protecting waiting
+		Job *			waiting;	//!< Jobs waiting for count to reach zero
+
+		// Not copyable
+		JobCounter( const JobCounter &other );
+		JobCounter &operator=( const JobCounter &other );
 	};
 
 	// ==============================================================================
@@ -53,6 +147,11 @@ namespace og {
 	// ==============================================================================
 	class Job {
 	public:
+		// ==============================================================================
+		//! Default constructor
+		// ==============================================================================
+		Job() : jobCounter(OG_NULL), nextWaiting(OG_NULL), resumeCounter(OG_NULL), priority(JOB_PRIORITY_FRAME), queuedTime(0) {}
+
 		// ==============================================================================
 		//! Virtual destructor
 		// ==============================================================================
@@ -73,6 +172,76 @@ namespace og {
 		//! @return	JobResult: Default is JOB_DELETE, all others won't do anything
 		// ==============================================================================
 		virtual JobResult	Cancel( void ) { return JOB_DELETE; }
+
+		// ==============================================================================
+		//! Get the name shown in traces
+		//!
+		//! @return	The name, must stay valid after the job is gone ( use string literals )
+		//!
+		//! @see JobManager::StartTrace
+		// ==============================================================================
+		virtual const char *GetName( void ) const { return "Job"; }
+
+		// ==============================================================================
+		//! Get the counter this job decrements when it's finished
+		//!
+		//! @return	The counter passed to JobManager::AddJob, might be NULL
+		//!
+		//! @note	Add child jobs with this counter from within Execute(),
+		//!			so everyone waiting for this job will also wait for the children.
+		// ==============================================================================
+		JobCounter *		GetCounter( void ) const { return jobCounter; }
+
+		// ==============================================================================
+		//! Get the priority of this job
+		//!
+		//! @return	The priority passed to JobManager::AddJob
+		// ==============================================================================
+		JobPriority			GetPriority( void ) const { return priority; }
+
+		// ==============================================================================
+		//! Allocate a job from the pool
+		//!
+		//! @param	size	The size of the job object
+		//!
+		//! @note	Every thread keeps a cache of freed jobs per size class, so creating
+		//!			and deleting small jobs doesn't touch the heap once the pool is warm.
+		//!			Jobs bigger than MAX_POOLED_SIZE bytes use the heap directly.
+		// ==============================================================================
+		static void *		operator new( size_t size );
+
+		// ==============================================================================
+		//! Return a job to the pool of the current thread
+		//!
+		//! @param	ptr		The job object
+		//! @param	size	The size of the job object
+		// ==============================================================================
+		static void			operator delete( void *ptr, size_t size );
+
+		// ==============================================================================
+		//! Placement new, so containers can still construct jobs in their own memory
+		// ==============================================================================
+		static void *		operator new( size_t size, void *place ) { return place; }
+		static void			operator delete( void *ptr, void *place ) {}
+
+		static const int MAX_POOLED_SIZE = 256;	//!< Jobs up to this size get pooled
+
+	protected:
+		// ==============================================================================
+		//! Set the counter to wait for when Execute() returns JOB_SUSPEND
+		//!
+		//! @param	counter	The counter, the job still counts as unfinished until it's done
+		// ==============================================================================
+		void				SuspendUntil( JobCounter *counter ) { resumeCounter = counter; }
+
+	private:
+		friend class JobManager;
+
+		JobCounter *		jobCounter;		//!< The counter to decrement when done
+		Job *				nextWaiting;	//!< The next job waiting for the same dependency
+		JobCounter *		resumeCounter;	//!< The counter to wait for after JOB_SUSPEND
+		JobPriority			priority;		//!< The queues to use
+		uLongLong			queuedTime;		//!< When the job got queued, only set while tracing
 	};
 
 	// ==============================================================================
@@ -84,19 +253,32 @@ namespace og {
 		//! Constructor
 		//!
 		//! @param	_manager	The manager of this worker
+		//! @param	_slot		The index of the local job queue to use
 		// ==============================================================================
-		WorkerThread( JobManager *_manager ) : job(OG_NULL), manager(_manager) {}
+		WorkerThread( JobManager *_manager, int _slot ) : manager(_manager), slot(_slot), victimSeed(_slot * 2654435761u + 1), numSpins(-1) {}
 
 		// ==============================================================================
-		//! Set the new job
-		//!
-		//! @param	_job	The job
+		//! Wake up all idle workers of the manager, so a stopped worker notices it
 		// ==============================================================================
-		void SetJob( Job *_job ) { job = _job; }
+		void	WakeUp( void );
 
 	private:
-		Job *		job;		//!< The job
+		friend class JobManager;
+
 		JobManager *manager;	//!< The manager
+		int			slot;		//!< The index of the local job queue, -1 if released
+		uInt		victimSeed;	//!< Random state used to pick the workers to steal from
+		int			numSpins;	//!< The current number of spins while idle, -1 until the first idle phase
+
+		// ==============================================================================
+		//! Wait for new jobs and record the idle time if tracing
+		// ==============================================================================
+		void	Idle( void );
+
+		// ==============================================================================
+		//! Wait for new jobs: spin, yield, then sleep ( see JobIdlePolicy )
+		// ==============================================================================
+		void	IdleWait( void );
 
 	protected:
 		// ==============================================================================
@@ -107,13 +289,24 @@ namespace og {
 
 	// ==============================================================================
 	//! A job manager
+	//!
+	//! Every worker owns a local job queue. Jobs added from within a job go to the local
+	//! queue of that worker ( LIFO ), jobs added from other threads go to a global queue.
+	//! Workers without jobs steal from the global queue first, then from random other workers.
+	//!
+	//! Every priority has its own local and global queues, higher priorities are always
+	//! looked at first. Once the frame deadline has passed, no new background jobs get
+	//! started until the next deadline is set.
 	// ==============================================================================
 	class JobManager {
 	public:
+		static const int MAX_WORKERS = 64;	//!< The maximum number of workers per manager
+		static const int AUTO_WORKERS = -1;	//!< Pass to SetNumWorkers to use one worker per processor, except for the calling thread
+
 		// ==============================================================================
 		//! Default constructor
 		// ==============================================================================
-		JobManager() : numThreadsWanted(0), waitForDone(false) {}
+		JobManager();
 
 		// ==============================================================================
 		//! Destructor, kills all remaining untouched jobs, waits for the ones in progress
@@ -123,18 +316,124 @@ namespace og {
 		// ==============================================================================
 		//! Add a job to the queue
 		//!
-		//! @param	job	The job to add
+		//! @param	job			The job to add
+		//! @param	counter		If non-NULL, the counter to increment until the job is finished
+		//! @param	dependency	If non-NULL, the job won't be queued before this counter reaches zero
+		//! @param	priority	The priority of the job
+		//!
+		//! @note	When called from within a job of this manager, the job goes to the local queue
+		//!			of the current worker, so it will most likely be executed next on the same thread.
+		//! @note	While WaitForDone() is waiting, only jobs added from within a job are accepted,
+		//!			all others get canceled.
+		// ==============================================================================
+		void	AddJob( Job *job, JobCounter *counter=OG_NULL, JobCounter *dependency=OG_NULL, JobPriority priority=JOB_PRIORITY_FRAME );
+
+		// ==============================================================================
+		//! Add multiple jobs at once
+		//!
+		//! @param	jobs		The jobs to add
+		//! @param	num			Number of jobs
+		//! @param	counter		If non-NULL, the counter to increment until the jobs are finished
+		//! @param	dependency	If non-NULL, the jobs won't be queued before this counter reaches zero
+		//! @param	priority	The priority of the jobs
+		//!
+		//! @note	Wakes up no more workers than there are new jobs, all at once,
+		//!			instead of one wake up per job. Otherwise the same as AddJob.
 		// ==============================================================================
-		void	AddJob( Job *job );
+		void	AddJobs( Job **jobs, int num, JobCounter *counter=OG_NULL, JobCounter *dependency=OG_NULL, JobPriority priority=JOB_PRIORITY_FRAME );
+
+		// ==============================================================================
+		//! Wait for all jobs of a counter to be finished
+		//!
+		//! @param	counter	The counter to wait for
+		//!
+		//! @note	The calling thread helps out executing jobs while waiting,
+		//!			so this can also be called from within a job.
+		//! @note	The waiting thread also starts background jobs after the frame deadline,
+		//!			in case the counter depends on them.
+		// ==============================================================================
+		void	Wait( JobCounter &counter );
+
+		// ==============================================================================
+		//! Set the time by which the jobs of the current frame should be done
+		//!
+		//! @param	microseconds	Time from now, 0 to remove the deadline
+		//!
+		//! @note	Call this once per frame, so background jobs continue when the next frame starts.
+		// ==============================================================================
+		void	SetFrameDeadline( int microseconds );
+
+		// ==============================================================================
+		//! Find out if the frame deadline has passed
+		//!
+		//! @return	true if background jobs are being held back
+		// ==============================================================================
+		bool	IsFrameLate( void ) const;
 
 		// ==============================================================================
 		//! Change the number workers
 		//!
-		//! @param	num			Number of workers
+		//! @param	num			Number of workers ( at most MAX_WORKERS ), or AUTO_WORKERS
 		//! @param	blocking	Wait until the number of workers has been adapted
+		//!
+		//! @note	AUTO_WORKERS counts logical processors with JOB_AFFINITY_NONE and JOB_AFFINITY_LOGICAL,
+		//!			physical cores otherwise. Only those the process may run on are counted.
 		// ==============================================================================
 		void	SetNumWorkers( int num, bool blocking=false );
 
+		// ==============================================================================
+		//! Set where to place workers
+		//!
+		//! @param	affinity	The placement
+		//!
+		//! @note	Only affects workers started afterwards, so call it before SetNumWorkers
+		// ==============================================================================
+		void	SetAffinity( JobAffinity affinity ) { workerAffinity = affinity; }
+
+		// ==============================================================================
+		//! Set how idle workers wait for new jobs
+		//!
+		//! @param	policy	The idle policy
+		// ==============================================================================
+		void	SetIdlePolicy( const JobIdlePolicy &policy ) { idlePolicy = policy; }
+
+		// ==============================================================================
+		//! Start recording a trace
+		//!
+		//! @param	eventsPerThread	The size of the ring buffer of each thread, older events get overwritten
+		//!
+		//! @note	Records when and where each job ran, how long it waited in the queue,
+		//!			the number of queued jobs and when workers were idle.
+		//!			Previous recordings get discarded.
+		// ==============================================================================
+		void	StartTrace( int eventsPerThread=8192 );
+
+		// ==============================================================================
+		//! Stop recording a trace
+		//!
+		//! @note	Waits for events which are being recorded right now
+		// ==============================================================================
+		void	StopTrace( void );
+
+		// ==============================================================================
+		//! Write the recorded trace as Chrome trace_event JSON ( load it in chrome://tracing )
+		//!
+		//! @param	file	The file to write to
+		//!
+		//! @return	false if there was nothing recorded
+		//!
+		//! @note	Call StopTrace() first. StartTrace() must not be called while writing.
+		//! @exception FileReadWriteError	Thrown when writing failed
+		// ==============================================================================
+		bool	WriteTrace( File *file ) const;
+
+		// ==============================================================================
+		//! Get the number of workers
+		//!
+		//! @return	The current number of workers
+		// ==============================================================================
+		int		GetNumWorkers( void ) const { return allThreads.Num(); }
+
 		// ==============================================================================
 		//! Wait for all jobs to be done
 		// ==============================================================================
@@ -149,66 +448,171 @@ namespace og {
 		friend class WorkerThread;
 
 		// ==============================================================================
-		//! Trigger the next job
+		//! Get the worker of this manager running on the current thread
+		//!
+		//! @return	NULL if the current thread is not a worker of this manager
+		// ==============================================================================
+		WorkerThread *GetLocalWorker( void ) const;
+
+		// ==============================================================================
+		//! Add a job to the local queue of the worker or the global queue and wake up a worker
+		//!
+		//! @param	job		The job to add
+		//! @param	worker	The local worker, NULL to add it to the global queue
+		// ==============================================================================
+		void	PushJob( Job *job, WorkerThread *worker );
+
+		// ==============================================================================
+		//! Add a job to the local queue of the worker or the global queue, without telling anyone
+		//!
+		//! @param	job		The job to add
+		//! @param	worker	The local worker, NULL to add it to the global queue
+		//!
+		//! @see JobsQueued
+		// ==============================================================================
+		void	QueueJob( Job *job, WorkerThread *worker );
+
+		// ==============================================================================
+		//! Update the queue counts after QueueJob and wake up as many workers as needed
+		//!
+		//! @param	num		Number of critical and frame jobs that have been queued
+		//! @param	numBg	Number of background jobs that have been queued
+		// ==============================================================================
+		void	JobsQueued( int num, int numBg );
+
+		// ==============================================================================
+		//! Find the next job ( local queue, global queue, then steal )
+		//!
+		//! @param	worker			The worker, NULL if called from another thread
+		//! @param	seed			Random state for picking the victims to steal from
+		//! @param	allowBackground	Look at background jobs even if the frame is late
+		//!
+		//! @return	NULL if no job was found
+		// ==============================================================================
+		Job *	FindJob( WorkerThread *worker, uInt &seed, bool allowBackground );
+
+		// ==============================================================================
+		//! Steal a job from a random worker
+		//!
+		//! @param	skipSlot	The local queue not to steal from, -1 for none
+		//! @param	seed		Random state for picking the victims
+		//! @param	priority	The priority of the queues to steal from
+		//!
+		//! @return	NULL if no job was found
+		// ==============================================================================
+		Job *	StealJob( int skipSlot, uInt &seed, int priority );
+
+		// ==============================================================================
+		//! Find out if there are jobs that may be started
+		//!
+		//! @param	allowBackground	Count background jobs even if the frame is late
+		//!
+		//! @return	true if there are queued jobs
+		// ==============================================================================
+		bool	HasQueuedJobs( bool allowBackground ) const;
+
+		// ==============================================================================
+		//! Let a job wait for a counter to reach zero
+		//!
+		//! @param	job			The job
+		//! @param	dependency	The counter to wait for
+		//!
+		//! @return	false if the counter is zero already and the job can be queued right away
+		// ==============================================================================
+		bool	AddWaitingJob( Job *job, JobCounter *dependency );
+
+		// ==============================================================================
+		//! Add an event to the trace buffer of the current thread
+		//!
+		//! @param	name	The job name, NULL for idle time
+		//! @param	queued	When the job got queued
+		//! @param	start	When the job started
+		//! @param	end		When the job finished
+		//! @param	depth	The number of queued jobs when it started
 		// ==============================================================================
-		void	TriggerNextJob( bool wakeUp=true );
+		void	TraceEvent( const char *name, uLongLong queued, uLongLong start, uLongLong end, int depth );
 
 		// ==============================================================================
-		//! A worker is done
+		//! Decrement a counter and queue the jobs waiting for it once it reaches zero
+		//!
+		//! @param	counter	The counter
+		// ==============================================================================
+		void	DecrementCounter( JobCounter *counter );
+
+		// ==============================================================================
+		//! Execute a job and handle its result
+		//!
+		//! @param	job	The job
+		// ==============================================================================
+		void	ExecuteJob( Job *job );
+
+		// ==============================================================================
+		//! Cancel a job that has been taken out of a queue
+		//!
+		//! @param	job	The job
+		// ==============================================================================
+		void	CancelJob( Job *job );
+
+		// ==============================================================================
+		//! A job has been executed or canceled, signals WaitForDone() if it was the last one
+		// ==============================================================================
+		void	JobFinished( void );
+
+		// ==============================================================================
+		//! A worker is done with a job, stops the worker if there are too many
 		//!
 		//! @param	worker	The worker
 		// ==============================================================================
 		void	WorkerIsDone( WorkerThread *worker );
 
 		// ==============================================================================
-		//! Add a free worker
+		//! Find an unused local job queue ( listMutex must be locked )
+		//!
+		//! @return	The index of the queue, -1 if none is available
+		// ==============================================================================
+		int		AllocQueue( void );
+
+		// ==============================================================================
+		//! Move the remaining jobs of a worker to the global queue and
+		//! release its local queue ( listMutex must be locked, called from the worker itself )
+		//!
+		//! @param	worker	The worker
+		// ==============================================================================
+		void	ReleaseQueue( WorkerThread *worker );
+
+		// ==============================================================================
+		//! Get the affinity mask for a worker
+		//!
+		//! @param	slot	The queue index of the worker
 		//!
-		//! @param	worker	The worker. 
+		//! @return	The affinity mask, 0 for any processor
 		// ==============================================================================
-		void	AddFreeWorker( WorkerThread *worker, bool wakeUp=true );
+		uLongLong	GetWorkerAffinity( int slot ) const;
 
-		ogst::mutex					listMutex;			//!< Protects numThreadsWanted and allThreads
-		int							numThreadsWanted;	//!< The number of wanted threads wanted
+		ogst::mutex					listMutex;			//!< Protects numThreadsWanted, allThreads and the queue slots
+		volatile int				numThreadsWanted;	//!< The number of wanted threads wanted
+		JobAffinity					workerAffinity;		//!< Where to place new workers
+		JobIdlePolicy				idlePolicy;			//!< How idle workers wait
 		List<WorkerThread *>		allThreads;			//!< A list of all worker threads
-		bool						waitForDone;		//!< Waiting to be done ( see WaitForDone )
+		volatile bool				waitForDone;		//!< Waiting to be done ( see WaitForDone )
 		Condition					doneWaiter;			//!< The done waiter condition
-		LockFreeQueue<WorkerThread>	availableThreads;	//!< The available (job-less) threads
-		LockFreeQueue<Job>			jobList;			//!< The list of jobs to do
-
-		// ==============================================================================
-		//! The job that ends the WaitForDone()
-		// ==============================================================================
-		class JobStopWaitDone : public Job {
-		public:
-			// ==============================================================================
-			//! Constructor
-			//!
-			//! @param	mgr	The manager
-			// ==============================================================================
-			JobStopWaitDone( JobManager *mgr ) : manager(mgr) {}
-
-			// ==============================================================================
-			//! Stop waiting for done and signal the waiter
-			//!
-			//! @return	JOB_DELETE
-			// ==============================================================================
-			JobResult	Execute( void ) {
-				manager->waitForDone = false;
-				manager->doneWaiter.Signal();
-				return JOB_DELETE;
-			}
-
-			// ==============================================================================
-			//! Cancel should never be called on this one
-			// ==============================================================================
-			JobResult	Cancel( void ) {
-				OG_ASSERT( false );
-				return JOB_DELETE;
-			}
-
-		private:
-			JobManager *manager;	//!< The manager
-		};
+		Condition					idleCondition;		//!< Idle workers wait for this one
+		volatile int				numQueued;			//!< Number of critical and frame jobs waiting in any queue
+		volatile int				numBackground;		//!< Number of background jobs waiting in any queue
+		volatile bool				hasDeadline;		//!< frameDeadline is set
+		volatile int				frameDeadline;		//!< The frame deadline in microseconds ( lower 32 bits of GetHiResTime )
+		volatile int				numActive;			//!< Number of jobs queued or in progress
+		volatile int				numSleeping;		//!< Number of threads waiting on idleCondition
+		volatile int				numWaiting;			//!< Number of threads waiting for a counter ( see Wait )
+		volatile int				numQueues;			//!< Number of created local queues ( never shrinks )
+		WorkStealingQueue<Job> *	localQueues[MAX_WORKERS][JOB_PRIORITY_NUM];	//!< The local job queues of the workers
+		bool						queueInUse[MAX_WORKERS];	//!< Which local queues are assigned to a worker
+		LockFreeQueue<Job>			jobList[JOB_PRIORITY_NUM];	//!< The global job queues
+		volatile bool				isTracing;			//!< Recording a trace
+		volatile int				traceWriters;		//!< Number of threads inside TraceEvent
+		int							traceSize;			//!< The number of events per trace buffer
+		uLongLong					traceStart;			//!< When the trace started
+		JobTraceBuffer *			traceBuffers[MAX_WORKERS+1];	//!< One per worker and one shared by all other threads
 	};
 
 //! @}
@@ -1,7 +1,6 @@
 // ==============================================================================
 //! @file
-//! @brief	Lock Free Queue and Low Lock Queue
-//! @author	Herb Sutter: http://www.drdobbs.com/high-performance-computing/210604448
+//! @brief	Lock Free Queue
 //! @author	Santo Pfingsten (TTK-Bandit)
 //! @note	Copyright (C) 2007-2010 Lusito Software
 // ==============================================================================
@@ -32,33 +31,22 @@
 #ifndef __OG_LOCK_FREE_QUEUE_H__
 #define __OG_LOCK_FREE_QUEUE_H__
 
+#include <og/Common.h>
 #include <og/Common/Thread/Thread.h>
-
-struct lfds611_queue_state;
+#include <og/Common/Thread/RingQueue.h>
 
 //! Open Game Libraries
 namespace og {
 //! @defgroup Common Common (Library)
 //! @{
 
-	// ==============================================================================
-	//! Lock free queue wrapper class, not to be used directly, as it's not type safe
-	// ==============================================================================
-	class LockFreeQueueVoid {
-	public:
-		LockFreeQueueVoid( int size );
-		~LockFreeQueueVoid();
-
-		bool Produce( void *data );
-		bool ProduceSafe( void *data );
-		bool Consume( void **data );
-
-	private:
-		struct lfds611_queue_state *queueState;
-	};
-
 	// ==============================================================================
 	//! Lock free queue for multi producer multi consumer scenarios
+	//!
+	//! Built on a bounded RingQueue, so the common case neither locks nor allocates.
+	//! If the ring is full, Produce spills into a locked overflow queue instead of failing.
+	//! Once something has spilled, producers keep using the overflow until it got drained,
+	//! so the order of the entries is preserved.
 	// ==============================================================================
 	template<typename type>
 	class LockFreeQueue {
@@ -66,17 +54,35 @@ namespace og {
 		// ==============================================================================
 		//! Default constructor
 		//!
-		//! @param	size	The maximum number of elements which can be present in the queue.
+		//! @param	size	The number of elements the ring can hold before spilling ( gets rounded up to a power of two )
+		// ==============================================================================
+		LockFreeQueue( int size=1024 ) : ring(size), numOverflow(0) {}
+
+		// ==============================================================================
+		//! Add an entry to the queue, without spilling into the overflow queue
+		//!
+		//! @param	data	A pointer to the object
+		//!
+		//! @return	false if the ring is full ( or still spilled ), so the caller can back off
 		// ==============================================================================
-		LockFreeQueue( int size=100 ) : queue(size) {}
+		bool TryProduce( type *data ) {
+			return numOverflow == 0 && ring.TryProduce( data );
+		}
 
 		// ==============================================================================
 		//! Add an entry to the queue
 		//!
 		//! @param	data	A pointer to the object
+		//!
+		//! @return	Always true
 		// ==============================================================================
 		bool Produce( type *data ) {
-			return queue.ProduceSafe( (void *)data );
+			if ( TryProduce( data ) )
+				return true;
+			ogst::lock_guard<ogst::mutex> lock(overflowMutex);
+			overflow.Push( data );
+			AtomicIncrement( &numOverflow );
+			return true;
 		}
 
 		// ==============================================================================
@@ -85,15 +91,37 @@ namespace og {
 		//! @return	NULL if the queue is empty, otherwise the next entry
 		// ==============================================================================
 		type *Consume( void ) {
-			void *p;
-			if( queue.Consume(&p) ) {
-				return (type *)p;
-			}
-			return OG_NULL;
+			type *data;
+			if ( ring.TryConsume( data ) )
+				return data;
+			if ( numOverflow == 0 )
+				return OG_NULL;
+
+			ogst::lock_guard<ogst::mutex> lock(overflowMutex);
+			if ( overflow.IsEmpty() )
+				return OG_NULL;
+			data = overflow.Front();
+			overflow.Pop();
+			AtomicDecrement( &numOverflow );
+			return data;
 		}
-		
+
+		// ==============================================================================
+		//! Get the approximate number of entries
+		//!
+		//! @return	The number of entries, might be outdated as soon as it returns
+		// ==============================================================================
+		int Num( void ) const { return ring.Num() + numOverflow; }
+
 	private:
-		LockFreeQueueVoid queue;	//!< The queue
+		RingQueue<type *>	ring;			//!< The lock free part
+		volatile int		numOverflow;	//!< Number of entries in the overflow queue
+		Queue<type *>		overflow;		//!< Entries that did not fit into the ring
+		ogst::mutex			overflowMutex;	//!< Protects the overflow queue
+
+		// Not copyable
+		LockFreeQueue( const LockFreeQueue &other );
+		LockFreeQueue &operator=( const LockFreeQueue &other );
 	};
 
 	//! @}
@@ -0,0 +1,255 @@
+// ==============================================================================
+//! @file
+//! @brief	Parallel loops on top of the JobManager
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_PARALLEL_H__
+#define __OG_PARALLEL_H__
+
+#include <og/Common/Thread/JobManager.h>
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// ==============================================================================
+	//! A range of indices shared by all threads of a parallel loop
+	//!
+	//! Every thread grabs chunks from the front, the chunks get smaller the less
+	//! indices are left ( guided scheduling ), but never smaller than the grain size.
+	// ==============================================================================
+	class ParallelRange {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	begin		The first index
+		//! @param	end			One past the last index
+		//! @param	grain		The minimum number of indices per chunk
+		//! @param	numThreads	The number of threads working on this range
+		// ==============================================================================
+		ParallelRange( int begin, int end, int grain, int numThreads )
+			: next(begin), last(end), minChunk(grain), divisor(2 * numThreads) {}
+
+		// ==============================================================================
+		//! Grab the next chunk
+		//!
+		//! @param	first	Set to the first index of the chunk
+		//! @param	end		Set to one past the last index of the chunk
+		//!
+		//! @return	false if no indices are left
+		// ==============================================================================
+		bool	Next( int &first, int &end ) {
+			for(;;) {
+				int start = next;
+				if ( start >= last )
+					return false;
+				int stop = start + Max( minChunk, (last - start) / divisor );
+				if ( stop > last )
+					stop = last;
+				if ( AtomicCompareExchange( &next, stop, start ) == start ) {
+					first = start;
+					end = stop;
+					return true;
+				}
+			}
+		}
+
+	private:
+		volatile int	next;		//!< The next index to hand out
+		int				last;		//!< One past the last index
+		int				minChunk;	//!< The minimum chunk size
+		int				divisor;	//!< Remaining indices get divided by this to get the chunk size
+	};
+
+	// ==============================================================================
+	//! Helper job for ParallelFor
+	// ==============================================================================
+	template<class Func>
+	class ParallelForJob : public Job {
+	public:
+		ParallelForJob() : range(OG_NULL), func(OG_NULL) {}
+
+		JobResult	Execute( void ) {
+			int first, end;
+			while( range->Next( first, end ) ) {
+				for( int i=first; i<end; i++ )
+					(*func)( i );
+			}
+			return JOB_DONE;
+		}
+
+		// Owned by ParallelFor, so never delete it
+		JobResult	Cancel( void ) { return JOB_DONE; }
+
+		const char *GetName( void ) const { return "ParallelFor"; }
+
+		ParallelRange *	range;	//!< The shared range
+		const Func *	func;	//!< The function object
+	};
+
+	// ==============================================================================
+	//! Helper job for ParallelReduce, holds the partial result of one thread
+	// ==============================================================================
+	template<class T, class Reducer>
+	class ParallelReduceJob : public Job {
+	public:
+		ParallelReduceJob() : range(OG_NULL), reducer(OG_NULL) {}
+
+		JobResult	Execute( void ) {
+			int first, end;
+			while( range->Next( first, end ) ) {
+				for( int i=first; i<end; i++ )
+					(*reducer)( i, value );
+			}
+			return JOB_DONE;
+		}
+
+		// Owned by ParallelReduce, so never delete it
+		JobResult	Cancel( void ) { return JOB_DONE; }
+
+		const char *GetName( void ) const { return "ParallelReduce"; }
+
+		ParallelRange *		range;		//!< The shared range
+		const Reducer *		reducer;	//!< The reducer object
+		T					value;		//!< The partial result
+	};
+
+	//! Number of helper jobs kept on the stack of ParallelFor and ParallelReduce, more go to the heap
+	const int PARALLEL_INLINE_JOBS = 8;
+
+	// ==============================================================================
+	//! Call a function object for every index in [begin, end) using all workers
+	//!
+	//! @param	manager	The job manager to use
+	//! @param	begin	The first index
+	//! @param	end		One past the last index
+	//! @param	grain	The minimum number of indices to process in one go
+	//! @param	func	The function object, called as func( index ) from multiple threads
+	//!
+	//! @note	The calling thread takes part and this returns once all indices are done.
+	//!			Up to PARALLEL_INLINE_JOBS helper jobs live on the stack, only more need heap memory.
+	// ==============================================================================
+	template<class Func>
+	void ParallelFor( JobManager &manager, int begin, int end, int grain, const Func &func ) {
+		if ( grain < 1 )
+			grain = 1;
+		int numChunks = (end - begin + grain - 1) / grain;
+		int numHelpers = Min( manager.GetNumWorkers(), numChunks - 1 );
+		if ( numHelpers <= 0 ) {
+			for( int i=begin; i<end; i++ )
+				func( i );
+			return;
+		}
+
+		ParallelRange range( begin, end, grain, numHelpers + 1 );
+		// Reserved up front, so the jobs never move once queued
+		SmallList<ParallelForJob<Func>, PARALLEL_INLINE_JOBS> jobs;
+		SmallList<Job *, PARALLEL_INLINE_JOBS> jobPtrs;
+		jobs.Reserve( numHelpers );
+		jobPtrs.Reserve( numHelpers );
+		for( int i=0; i<numHelpers; i++ ) {
+			ParallelForJob<Func> &job = jobs.EmplaceBack();
+			job.range = &range;
+			job.func = &func;
+			jobPtrs.Append( &job );
+		}
+		JobCounter counter;
+		manager.AddJobs( &jobPtrs[0], numHelpers, &counter );
+
+		// Do our part, then help out until the helpers are done too
+		int first, last;
+		while( range.Next( first, last ) ) {
+			for( int i=first; i<last; i++ )
+				func( i );
+		}
+		manager.Wait( counter );
+	}
+
+	// ==============================================================================
+	//! Reduce all indices in [begin, end) to one value using all workers
+	//!
+	//! @param	manager		The job manager to use
+	//! @param	begin		The first index
+	//! @param	end			One past the last index
+	//! @param	grain		The minimum number of indices to process in one go
+	//! @param	identity	The initial value of every partial result
+	//! @param	reducer		The reducer object, needs two const methods:
+	//!						operator()( int index, T &value ) to add an index to a partial result and
+	//!						Join( T &value, const T &other ) to merge two partial results
+	//!
+	//! @return	The joined result of all partial results
+	//!
+	//! @note	The partial results are joined in a fixed order on the calling thread,
+	//!			but which indices end up in which partial result is not deterministic.
+	// ==============================================================================
+	template<class T, class Reducer>
+	T ParallelReduce( JobManager &manager, int begin, int end, int grain, const T &identity, const Reducer &reducer ) {
+		if ( grain < 1 )
+			grain = 1;
+		T result = identity;
+		int numChunks = (end - begin + grain - 1) / grain;
+		int numHelpers = Min( manager.GetNumWorkers(), numChunks - 1 );
+		if ( numHelpers <= 0 ) {
+			for( int i=begin; i<end; i++ )
+				reducer( i, result );
+			return result;
+		}
+
+		ParallelRange range( begin, end, grain, numHelpers + 1 );
+		// Reserved up front, so the jobs never move once queued
+		SmallList<ParallelReduceJob<T, Reducer>, PARALLEL_INLINE_JOBS> jobs;
+		SmallList<Job *, PARALLEL_INLINE_JOBS> jobPtrs;
+		jobs.Reserve( numHelpers );
+		jobPtrs.Reserve( numHelpers );
+		for( int i=0; i<numHelpers; i++ ) {
+			ParallelReduceJob<T, Reducer> &job = jobs.EmplaceBack();
+			job.range = &range;
+			job.reducer = &reducer;
+			job.value = identity;
+			jobPtrs.Append( &job );
+		}
+		JobCounter counter;
+		manager.AddJobs( &jobPtrs[0], numHelpers, &counter );
+
+		int first, last;
+		while( range.Next( first, last ) ) {
+			for( int i=first; i<last; i++ )
+				reducer( i, result );
+		}
+		manager.Wait( counter );
+
+		for( int i=0; i<numHelpers; i++ )
+			reducer.Join( result, jobs[i].value );
+		return result;
+	}
+
+//! @}
+}
+
+#endif
@@ -45,7 +45,7 @@ namespace og {
 		// ==============================================================================
 		//! Default constructor
 		// ==============================================================================
-		PreloadTask() : isLoaded(false) {}
+		PreloadTask() : isLoaded(false), isDone(false), residentSize(0), estimatedSize(0), priority(0.0f), sequence(0) {}
 
 		// ==============================================================================
 		//! Virtual destructor
@@ -66,29 +66,112 @@ namespace og {
 		// ==============================================================================
 		virtual void	Synchronize( void ) = 0;
 
+		// ==============================================================================
+		//! Get the memory held by the preloaded data until it has been synchronized
+		//!
+		//! @return	The size in bytes
+		//!
+		//! @note	Called from the worker thread, right after Preload returned true
+		// ==============================================================================
+		virtual uLongLong	GetResidentSize( void ) const { return 0; }
+
+		// ==============================================================================
+		//! Estimate the memory the preloaded data will hold, before Preload gets called
+		//!
+		//! @return	The size in bytes
+		//!
+		//! @note	Called from PreloadManager::AddTask, so it must be cheap ( a file size for example )
+		// ==============================================================================
+		virtual uLongLong	GetEstimatedSize( void ) const { return 0; }
+
+		// ==============================================================================
+		//! Get the priority, tasks with lower values get started first
+		//!
+		//! @return	The priority, the distance to the camera for example
+		//!
+		//! @note	Called from PreloadManager::AddTask and PreloadManager::UpdatePriorities
+		// ==============================================================================
+		virtual float	GetPriority( void ) const { return 0.0f; }
+
+		// ==============================================================================
+		//! Find out if this task is still needed
+		//!
+		//! @return	false to cancel the task if it has not been started yet
+		//!
+		//! @note	Called from PreloadManager::UpdatePriorities
+		// ==============================================================================
+		virtual bool	IsRelevant( void ) const { return true; }
+
 	private:
 		friend class PreloadJob;
 		friend class PreloadManager;
 
-		bool	isLoaded;	//!< The return value of Preload()
+		bool		isLoaded;		//!< The return value of Preload()
+		bool		isDone;			//!< Preload() has finished
+		uLongLong	residentSize;	//!< The result of GetResidentSize()
+		uLongLong	estimatedSize;	//!< The result of GetEstimatedSize()
+		float		priority;		//!< The result of GetPriority()
+		int			sequence;		//!< Order of AddTask calls, for equal priorities
+	};
+
+	// ==============================================================================
+	//! Timing statistics of PreloadManager::Synchronize, all times in microseconds
+	// ==============================================================================
+	class PreloadSyncStats {
+	public:
+		PreloadSyncStats() { Reset(); }
+
+		// ==============================================================================
+		//! Reset all values to 0
+		// ==============================================================================
+		void	Reset( void ) {
+			numTasks = 0;
+			totalTime = 0;
+			maxTime = 0;
+			lastTime = 0;
+			lastNumTasks = 0;
+			lastNumDeferred = 0;
+		}
+
+		// ==============================================================================
+		//! Get the average time PreloadTask::Synchronize took
+		//!
+		//! @return	The average time per task
+		// ==============================================================================
+		uLongLong	GetAverageTime( void ) const { return numTasks > 0 ? totalTime / numTasks : 0; }
+
+		uLongLong	numTasks;			//!< Number of synchronized tasks
+		uLongLong	totalTime;			//!< Time spent in PreloadTask::Synchronize
+		uLongLong	maxTime;			//!< The most expensive PreloadTask::Synchronize
+		uLongLong	lastTime;			//!< Time spent in the last PreloadManager::Synchronize
+		int			lastNumTasks;		//!< Number of tasks the last PreloadManager::Synchronize merged
+		int			lastNumDeferred;	//!< Number of finished tasks the last PreloadManager::Synchronize left for the next one
 	};
 
 	// ==============================================================================
 	//! Background data loading/generation, threaded
+	//!
+	//! Preload tasks run in parallel on all workers. Instead of blocking workers,
+	//! new tasks are only started while the estimated size of the running tasks
+	//! and the preloaded, but not yet synchronized data stay within the memory budget.
+	//! Waiting tasks get started by priority, Synchronize merges the tasks in the
+	//! order they have been started.
 	// ==============================================================================
 	class PreloadManager {
 	public:
+		static const uLongLong DEFAULT_BUDGET = 64*1024*1024;	//!< The default memory budget in bytes
+
 		// ==============================================================================
 		//! Default constructor
 		// ==============================================================================
 		PreloadManager();
 
 		// ==============================================================================
-		//! Start the background loader with one worker thread
+		//! Start the background loader with one worker thread per processor
 		//!
-		//! @param	num		The maximum number of preload tasks to be processed before the Synchronize
+		//! @see	SetBudget
 		// ==============================================================================
-		void	Start( int num=16 );
+		void	Start( void );
 
 		// ==============================================================================
 		//! Kill all remaining preload tasks, stop the worker threads and reset the progess
@@ -98,10 +181,20 @@ namespace og {
 		// ==============================================================================
 		//! Set the number of worker threads
 		//!
-		//! @param	num		The new number of worker threads
+		//! @param	num		The new number of worker threads, or JobManager::AUTO_WORKERS
 		// ==============================================================================
 		void	SetNumWorkers( int num );
 
+		// ==============================================================================
+		//! Set the memory budget
+		//!
+		//! @param	budget	The maximum number of bytes preloaded tasks may hold before the Synchronize
+		//!
+		//! @note	A task bigger than the whole budget still gets started once nothing else is held
+		//! @note	Defaults to DEFAULT_BUDGET
+		// ==============================================================================
+		void	SetBudget( uLongLong budget );
+
 		// ==============================================================================
 		//! Add a preload task
 		//!
@@ -109,12 +202,46 @@ namespace og {
 		// ==============================================================================
 		void	AddTask( PreloadTask *task );
 
+		// ==============================================================================
+		//! Cancel a task, if it has not been started yet
+		//!
+		//! @param	task	The task to cancel, gets deleted on success
+		//!
+		//! @return	true if the task has been cancelled, false if it's already running or done
+		// ==============================================================================
+		bool	CancelTask( PreloadTask *task );
+
+		// ==============================================================================
+		//! Ask all waiting tasks for their current priority and cancel the irrelevant ones
+		//!
+		//! @note	Call this when the priorities changed, after the camera moved for example
+		// ==============================================================================
+		void	UpdatePriorities( void );
+
 		// ==============================================================================
 		//! Synchronize the processed preload tasks
 		//!
+		//! @param	budgetMicroseconds	Stop merging once this much time has been spent, 0 for no limit
+		//!
 		//! @return	The current progress in percent
+		//!
+		//! @note	Tasks get synchronized in the order they have been started,
+		//!			so a finished task waits for all tasks started before it
+		//! @note	At least one finished task gets merged per call, the rest is left for the next call
+		// ==============================================================================
+		float	Synchronize( int budgetMicroseconds=0 );
+
+		// ==============================================================================
+		//! Get the timing statistics of Synchronize, to tune the time budget
+		//!
+		//! @return	The statistics since the last ResetSyncStats
 		// ==============================================================================
-		float	Synchronize( void );
+		const PreloadSyncStats &GetSyncStats( void ) const { return syncStats; }
+
+		// ==============================================================================
+		//! Reset the timing statistics of Synchronize
+		// ==============================================================================
+		void	ResetSyncStats( void ) { syncStats.Reset(); }
 
 		// ==============================================================================
 		//! Get the current progress in percent
@@ -123,6 +250,13 @@ namespace og {
 		// ==============================================================================
 		float	GetProgress( void ) const { return progress; }
 
+		// ==============================================================================
+		//! Get the memory currently held by preloaded tasks
+		//!
+		//! @return	The size in bytes
+		// ==============================================================================
+		uLongLong	GetResidentBytes( void ) const { return residentBytes; }
+
 		// ==============================================================================
 		//! Find out if all preload tasks have been processed
 		//!
@@ -138,13 +272,43 @@ namespace og {
 	private:
 		friend class PreloadJob;
 
-		JobManager	manager;			//!< The manager
-		float		progress;			//!< The current progress
-		int			maxPreload;			//!< The maximum number of preload tasks to be processed before the Synchronize
-		Queue<PreloadTask *> preloaded;	//!< The preload tasks that have been processed
-		Condition	condition;			//!< The condition
-		int			numProcessed;		//!< Number of processed preload tasks
-		int			numTotal;			//!< Total number of preload tasks
+		// ==============================================================================
+		//! Called by the worker once a task has been preloaded
+		//!
+		//! @param	task	The preloaded task
+		// ==============================================================================
+		void	TaskDone( PreloadTask *task );
+
+		// ==============================================================================
+		//! Start waiting tasks as long as the budget allows ( lock must be held )
+		// ==============================================================================
+		void	Dispatch( void );
+
+		// ==============================================================================
+		//! Heap operations on the waiting tasks ( lock must be held )
+		// ==============================================================================
+		static bool	IsBefore( const PreloadTask *a, const PreloadTask *b );
+		void	PushWaiting( PreloadTask *task );
+		void	RemoveWaiting( int index );
+		void	SiftUp( int index );
+		void	SiftDown( int index );
+
+		JobManager	manager;				//!< The manager
+		ogst::mutex	mutex;					//!< Protects the task queues and the budget
+		bool		isRunning;				//!< false once stopped, so no new tasks get started
+		float		progress;				//!< The current progress
+		uLongLong	budget;					//!< The memory budget in bytes
+		uLongLong	residentBytes;			//!< Memory held by tasks that have been preloaded, but not synchronized
+		uLongLong	runningBytes;			//!< Estimated memory of the tasks currently preloading
+		int			numRunning;				//!< Number of tasks currently preloading
+		int			numFinished;			//!< Number of tasks preloaded, but not synchronized
+		int			maxRunning;				//!< Maximum number of tasks preloading at once
+		List<PreloadTask *>	waiting;		//!< The tasks that have not been started yet ( a heap, best priority first )
+		Queue<PreloadTask *> started;		//!< The started tasks, in the order they have been started
+		int			nextSequence;			//!< The sequence of the next added task
+		int			numProcessed;			//!< Number of processed preload tasks
+		PreloadSyncStats syncStats;			//!< Timing statistics of Synchronize
+		int			numTotal;				//!< Total number of preload tasks
 	};
 
 //! @}
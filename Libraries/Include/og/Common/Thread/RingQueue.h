@@ -0,0 +1,286 @@
+// ==============================================================================
+//! @file
+//! @brief	Bounded Ring Queues
+//! @author	Dmitry Vyukov: "Bounded MPMC queue" (1024cores.net)
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_RING_QUEUE_H__
+#define __OG_RING_QUEUE_H__
+
+#include <og/Common/Thread/Atomic.h>
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	//! Size of a cache line, used to keep the producer and consumer indices apart
+	const int RING_CACHE_LINE = 64;
+
+	// ==============================================================================
+	//! Lock free bounded queue for multi producer multi consumer scenarios
+	//!
+	//! Elements are stored by value in a preallocated ring buffer, so producing
+	//! and consuming never allocates. Every cell carries a sequence number, which
+	//! tells producers and consumers whose turn it is, so a slow thread never
+	//! blocks the cells of the others.
+	//! The capacity is fixed, TryProduce returns false once it's full.
+	// ==============================================================================
+	template<typename type>
+	class RingQueue {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	size	The maximum number of elements ( gets rounded up to a power of two )
+		// ==============================================================================
+		RingQueue( int size=1024 ) : enqueuePos(0), dequeuePos(0) {
+			int capacity = 2;
+			while( capacity < size )
+				capacity <<= 1;
+			mask = capacity - 1;
+			cells = new Cell[capacity];
+			for( int i=0; i<capacity; i++ )
+				cells[i].sequence = i;
+		}
+
+		// ==============================================================================
+		//! Destructor
+		// ==============================================================================
+		~RingQueue() { delete[] cells; }
+
+		// ==============================================================================
+		//! Get the capacity
+		//!
+		//! @return	The maximum number of elements
+		// ==============================================================================
+		int		Capacity( void ) const { return mask + 1; }
+
+		// ==============================================================================
+		//! Get the approximate number of entries
+		//!
+		//! @return	The number of entries, might be outdated as soon as it returns
+		// ==============================================================================
+		int		Num( void ) const {
+			int num = Distance( dequeuePos, enqueuePos );
+			return num > 0 ? num : 0;
+		}
+
+		// ==============================================================================
+		//! Add an entry to the queue
+		//!
+		//! @param	data	The object to copy into the queue
+		//!
+		//! @return	false if the queue is full
+		// ==============================================================================
+		bool	TryProduce( const type &data ) {
+			Cell *cell;
+			int pos = enqueuePos;
+			for(;;) {
+				cell = &cells[pos & mask];
+				int diff = Distance( pos, AtomicLoadAcquire( &cell->sequence ) );
+				if ( diff == 0 ) {
+					int prev = AtomicCompareExchange( &enqueuePos, pos + 1, pos );
+					if ( prev == pos )
+						break;
+					pos = prev;
+				} else if ( diff < 0 ) {
+					return false;
+				} else {
+					pos = enqueuePos;
+				}
+			}
+			cell->data = data;
+			AtomicStoreRelease( &cell->sequence, pos + 1 );
+			return true;
+		}
+
+		// ==============================================================================
+		//! Get the oldest entry and remove it from the queue
+		//!
+		//! @param	data	Receives the entry
+		//!
+		//! @return	false if the queue is empty
+		// ==============================================================================
+		bool	TryConsume( type &data ) {
+			Cell *cell;
+			int pos = dequeuePos;
+			for(;;) {
+				cell = &cells[pos & mask];
+				int diff = Distance( pos + 1, AtomicLoadAcquire( &cell->sequence ) );
+				if ( diff == 0 ) {
+					int prev = AtomicCompareExchange( &dequeuePos, pos + 1, pos );
+					if ( prev == pos )
+						break;
+					pos = prev;
+				} else if ( diff < 0 ) {
+					return false;
+				} else {
+					pos = dequeuePos;
+				}
+			}
+			data = cell->data;
+			AtomicStoreRelease( &cell->sequence, pos + mask + 1 );
+			return true;
+		}
+
+	private:
+		// ==============================================================================
+		//! Distance between two indices, safe for wrap arounds
+		// ==============================================================================
+		static int	Distance( int from, int to ) {
+			return static_cast<int>( static_cast<uInt>(to) - static_cast<uInt>(from) );
+		}
+
+		struct Cell {
+			volatile int	sequence;	//!< The position this cell is ready for
+			type			data;		//!< The stored element
+		};
+
+		Cell *			cells;		//!< The ring buffer
+		int				mask;		//!< capacity - 1
+		char			pad0[RING_CACHE_LINE];
+		volatile int	enqueuePos;	//!< Next position to produce to
+		char			pad1[RING_CACHE_LINE - sizeof(int)];
+		volatile int	dequeuePos;	//!< Next position to consume from
+		char			pad2[RING_CACHE_LINE - sizeof(int)];
+
+		// Not copyable
+		RingQueue( const RingQueue &other );
+		RingQueue &operator=( const RingQueue &other );
+	};
+
+	// ==============================================================================
+	//! Lock free bounded queue for single producer single consumer scenarios
+	//!
+	//! Cheaper than RingQueue, as no compare and swap is needed:
+	//! only one thread may ever produce and only one thread may ever consume.
+	//! The capacity is fixed, TryProduce returns false once it's full.
+	// ==============================================================================
+	template<typename type>
+	class SpscRingQueue {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	size	The maximum number of elements ( gets rounded up to a power of two )
+		// ==============================================================================
+		SpscRingQueue( int size=1024 ) : head(0), cachedTail(0), tail(0), cachedHead(0) {
+			int capacity = 2;
+			while( capacity < size )
+				capacity <<= 1;
+			mask = capacity - 1;
+			list = new type[capacity];
+		}
+
+		// ==============================================================================
+		//! Destructor
+		// ==============================================================================
+		~SpscRingQueue() { delete[] list; }
+
+		// ==============================================================================
+		//! Get the capacity
+		//!
+		//! @return	The maximum number of elements
+		// ==============================================================================
+		int		Capacity( void ) const { return mask + 1; }
+
+		// ==============================================================================
+		//! Get the approximate number of entries
+		//!
+		//! @return	The number of entries, might be outdated as soon as it returns
+		// ==============================================================================
+		int		Num( void ) const {
+			int num = Distance( tail, head );
+			return num > 0 ? num : 0;
+		}
+
+		// ==============================================================================
+		//! Add an entry to the queue ( producer only )
+		//!
+		//! @param	data	The object to copy into the queue
+		//!
+		//! @return	false if the queue is full
+		// ==============================================================================
+		bool	TryProduce( const type &data ) {
+			int h = head;
+			if ( Distance( cachedTail, h ) > mask ) {
+				cachedTail = AtomicLoadAcquire( &tail );
+				if ( Distance( cachedTail, h ) > mask )
+					return false;
+			}
+			list[h & mask] = data;
+			AtomicStoreRelease( &head, h + 1 );
+			return true;
+		}
+
+		// ==============================================================================
+		//! Get the oldest entry and remove it from the queue ( consumer only )
+		//!
+		//! @param	data	Receives the entry
+		//!
+		//! @return	false if the queue is empty
+		// ==============================================================================
+		bool	TryConsume( type &data ) {
+			int t = tail;
+			if ( t == cachedHead ) {
+				cachedHead = AtomicLoadAcquire( &head );
+				if ( t == cachedHead )
+					return false;
+			}
+			data = list[t & mask];
+			AtomicStoreRelease( &tail, t + 1 );
+			return true;
+		}
+
+	private:
+		// ==============================================================================
+		//! Distance between two indices, safe for wrap arounds
+		// ==============================================================================
+		static int	Distance( int from, int to ) {
+			return static_cast<int>( static_cast<uInt>(to) - static_cast<uInt>(from) );
+		}
+
+		type *			list;		//!< The ring buffer
+		int				mask;		//!< capacity - 1
+		char			pad0[RING_CACHE_LINE];
+		volatile int	head;		//!< Next index to produce to ( written by the producer )
+		int				cachedTail;	//!< The producers last view of tail
+		char			pad1[RING_CACHE_LINE - 2 * sizeof(int)];
+		volatile int	tail;		//!< Next index to consume from ( written by the consumer )
+		int				cachedHead;	//!< The consumers last view of head
+		char			pad2[RING_CACHE_LINE - 2 * sizeof(int)];
+
+		// Not copyable
+		SpscRingQueue( const SpscRingQueue &other );
+		SpscRingQueue &operator=( const SpscRingQueue &other );
+	};
+
+	//! @}
+}
+
+#endif
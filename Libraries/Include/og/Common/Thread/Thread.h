@@ -31,6 +31,7 @@
 #define __OG_THREAD_H__
 
 #include <og/Shared.h>
+#include <og/Common/Thread/Atomic.h>
 #if OG_HAVE_STD_THREAD
 	#include <thread>
 	#include <condition_variable>
@@ -118,46 +119,100 @@ namespace og {
 			ogst::lock_guard<ogst::mutex> lock2(mutex);
 			condition.notify_one();
 		}
+
+		// ==============================================================================
+		//! Lock the mutex and signal all waiting threads ( notify_all )
+		// ==============================================================================
+		void	Broadcast( void ) {
+			ogst::lock_guard<ogst::mutex> lock2(mutex);
+			condition.notify_all();
+		}
 	};
 
 	// ==============================================================================
 	//! Shared mutex ( single writer multi reader )
+	//!
+	//! All state lives in one atomic word, so taking and releasing a lock
+	//! costs a single atomic operation as long as nobody needs to wait.
+	//! Waiting writers are preferred: new readers wait until they are done.
+	//! Threads that have to wait spin for a short while, then sleep.
+	//!
+	//! @note	Not recursive, don't lock shared again while you already hold it.
 	// ==============================================================================
 	class SharedMutex {
 	private:
-		ogst::mutex	mutex;						//!< The mutex
-		bool		exclusive;					//!< Exclusively locked
-		int			exclusiveRequests;			//!< Number of exclusive locks requested
-												//! (waiting for the shared locks to be done)
-		int			numShared;					//!< Number of shared locks
-		ogst::condition_variable exclusiveCond;	//!< The exclusive condition
-		ogst::condition_variable sharedCond;	//!< The shared condition
+		static const int READER_MASK	= 0x000FFFFF;	//!< Bits counting the readers
+		static const int WRITER_WAITING	= 0x00100000;	//!< One waiting writer
+		static const int WAITING_MASK	= 0x3FF00000;	//!< Bits counting the waiting writers
+		static const int WRITER			= 0x40000000;	//!< Set while a writer holds the lock
+
+		volatile int	state;						//!< Readers, waiting writers and the writer bit
+		volatile int	numParked;					//!< Number of threads sleeping in Park
+		ogst::mutex		parkMutex;					//!< The mutex for parkCond
+		ogst::condition_variable parkCond;			//!< Sleeping threads wait for this
+
+		// ==============================================================================
+		//! Slow paths, when the lock could not be taken right away
+		// ==============================================================================
+		void	LockSharedSlow( void );
+		void	LockSlow( void );
+
+		// ==============================================================================
+		//! Sleep until none of the bits in mask are set in state
+		//!
+		//! @param	mask	The blocking bits
+		// ==============================================================================
+		void	Park( int mask );
+
+		// ==============================================================================
+		//! Wake up all sleeping threads
+		// ==============================================================================
+		void	WakeParked( void );
+
+		// Not copyable
+		SharedMutex( const SharedMutex &other );
+		SharedMutex &operator=( const SharedMutex &other );
 
 	public:
 		// ==============================================================================
 		//! Default constructor
 		// ==============================================================================
-		SharedMutex() : exclusive(false), exclusiveRequests(0), numShared(0) {}
+		SharedMutex() : state(0), numParked(0) {}
 
 		// ==============================================================================
 		//! Lock shared ( for reading )
 		// ==============================================================================
-		void lock_shared( void );
+		void lock_shared( void ) {
+			int s = state;
+			if ( (s & ~READER_MASK) != 0 || AtomicCompareExchange( &state, s + 1, s ) != s )
+				LockSharedSlow();
+		}
 
 		// ==============================================================================
 		//! Unlock shared ( for reading )
 		// ==============================================================================
-		void unlock_shared( void );
+		void unlock_shared( void ) {
+			int s = AtomicDecrement( &state );
+			if ( (s & READER_MASK) == 0 && numParked > 0 )
+				WakeParked();
+		}
 
 		// ==============================================================================
 		//! Lock exclusively ( for writing )
 		// ==============================================================================
-		void lock( void );
+		void lock( void ) {
+			if ( AtomicCompareExchange( &state, WRITER, 0 ) != 0 )
+				LockSlow();
+		}
 
 		// ==============================================================================
 		//! Unlock exclusively ( for writing )
 		// ==============================================================================
-		void unlock( void );
+		void unlock( void ) {
+			AtomicAdd( &state, -WRITER );
+			if ( numParked > 0 )
+				WakeParked();
+		}
 	};
 
 	// ==============================================================================
@@ -242,6 +297,15 @@ namespace og {
 		// ==============================================================================
 		bool		Start( const char *name, bool waitForInit=false );
 
+		// ==============================================================================
+		//! Set the processors the thread may run on
+		//!
+		//! @param	mask	Bit i allows logical processor i ( see SysInfo::topology ), 0 for all
+		//!
+		//! @note	Call before Start(), not supported on Mac OS X
+		// ==============================================================================
+		void		SetAffinity( uLongLong mask ) { affinityMask = mask; }
+
 		// ==============================================================================
 		//! Stop the thread
 		//!
@@ -259,6 +323,27 @@ namespace og {
 		// ==============================================================================
 		virtual void	WakeUp( void ) { wakeUpEvent.Signal(); }
 
+		// ==============================================================================
+		//! Get a small number identifying the calling thread
+		//!
+		//! @return	The serial, starting at 1 and never reused within the process
+		//!
+		//! @note	Works for any thread, not just og::Thread objects
+		// ==============================================================================
+		static int	GetCurrentSerial( void );
+
+		static const int MAX_INDICES = 256;	//!< Number of thread indices handed out by GetCurrentIndex
+
+		// ==============================================================================
+		//! Get a small index for the calling thread, which gets reused once the thread ended
+		//!
+		//! @return	The lowest index not in use by another thread, -1 if all MAX_INDICES are taken
+		//!
+		//! @note	Use this to give every running thread its own slot in a fixed size table.
+		//!			The index gets released with the TLS data of the thread.
+		// ==============================================================================
+		static int	GetCurrentIndex( void );
+
 	protected:
 #if OG_WIN32
 		uInt		nativeId;		//!< The native thread id
@@ -276,6 +361,7 @@ namespace og {
 		bool		initResult;		//!< The result of Init()
 		bool		initIsDone;		//!< true when Init() has finished
 		bool		selfDestruct;	//!< Set to true if it should selfdestruct when done
+		uLongLong	affinityMask;	//!< The allowed processors, 0 for all
 
 		// ==============================================================================
 		//! Initialize the thread, run it and clean up afterwards
@@ -285,7 +371,7 @@ namespace og {
 		void		RunThread( Condition *initCondition );
 
 		// ==============================================================================
-		//! Platform initialization ( set thread name & get native id )
+		//! Platform initialization ( set thread name, affinity & get native id )
 		// ==============================================================================
 		void		PlatformInit( void );
 
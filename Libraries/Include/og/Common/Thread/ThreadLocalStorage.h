@@ -32,11 +32,21 @@
 
 #include <og/Shared.h>
 
+// Compiler supported thread local storage ( plain old data only )
+#if defined(_MSC_VER)
+	#define OG_THREAD_LOCAL __declspec(thread)
+#else
+	#define OG_THREAD_LOCAL __thread
+#endif
+
 //! Open Game Libraries
 namespace og {
 //! @defgroup Common Common (Library)
 //! @{
 
+	//! Maximum number of TLS objects
+	const int TLS_MAX_SLOTS = 64;
+
 	// ==============================================================================
 	//! TLS index
 	// ==============================================================================
@@ -79,48 +89,65 @@ namespace og {
 
 	// ==============================================================================
 	//! Basic TLS data
+	//!
+	//! Every thread keeps its TLS data in a compiler supported thread local slot table,
+	//! so looking up a value is a plain memory load, no system call involved.
 	// ==============================================================================
 	class TLS_Data {
 	public:
 		// ==============================================================================
 		//! Constructor
 		//!
-		//! @param	index	Pointer to the valid! TLS index
+		//! @param	slot	The valid! slot to register this data for on the calling thread
 		// ==============================================================================
-		TLS_Data( const TLS_Index *index );
+		TLS_Data( int slot );
 
 		// ==============================================================================
 		//! Destructor
-		//! 
-		//! Also deletes previous
 		// ==============================================================================
-		virtual ~TLS_Data();
+		virtual ~TLS_Data() {}
 
-	protected:
-		friend void TLS_AtExit( void );
-		friend class Thread;
+		// ==============================================================================
+		//! Allocate a new slot ( shared by all threads )
+		//!
+		//! @return	The slot index, -1 if all TLS_MAX_SLOTS slots are taken
+		// ==============================================================================
+		static int	AllocSlot( void );
 
 		// ==============================================================================
-		//! Register a new TLS_Data object
+		//! Get the data of the calling thread
+		//!
+		//! @param	slot	The valid! slot index
 		//!
-		//! @param	data	The TLS_Data object
+		//! @return	NULL if no data has been created for this slot on the calling thread
 		// ==============================================================================
-		static void Register( TLS_Data *data );
+		static TLS_Data *GetSlot( int slot ) { return slots[slot]; }
+
+	protected:
+		friend void TLS_AtExit( void );
+		friend class Thread;
 
 		// ==============================================================================
-		//! Delete all TLS data
+		//! Delete all TLS data of the calling thread
 		// ==============================================================================
 		static void Cleanup( void );
 
 	private:
-		TLS_Data *			previous;	//!< The previous data object ( for chain deletion )
-		const TLS_Index *	tlsIndex;	//!< The TLS index
+		TLS_Data *	previous;	//!< The previous data object ( for chain deletion )
+		int			slot;		//!< The slot index
+
+		static OG_THREAD_LOCAL TLS_Data *slots[TLS_MAX_SLOTS];	//!< The slot table of the calling thread
+		static OG_THREAD_LOCAL TLS_Data *lastData;				//!< The last created data of the calling thread
 	};
 
 	// ==============================================================================
 	//! Thread Local Storage
 	//!
-	//! @warning	Only use together with og::Thread
+	//! The value of a thread gets created on first access and deleted when the thread ends.
+	//!
+	//! @warning	Only use together with og::Thread ( or the main thread ) and only for
+	//!				objects with static storage duration, as every instance uses up one of
+	//!				the TLS_MAX_SLOTS slots for good.
 	// ==============================================================================
 	template<typename type>
 	class TLS {
@@ -133,10 +160,10 @@ namespace og {
 			// ==============================================================================
 			//! Constructor
 			//!
-			//! @param	index			Pointer to the valid! TLS index
+			//! @param	slot			The valid! slot index
 			//! @param	initialValue	The initial value
 			// ==============================================================================
-			TLS_DataEx( const TLS_Index *index, type initialValue ) : TLS_Data(index), value(initialValue) {}
+			TLS_DataEx( int slot, type initialValue ) : TLS_Data(slot), value(initialValue) {}
 
 		public:
 			type value;	//!< The value
@@ -148,33 +175,29 @@ namespace og {
 		//!
 		//! @param	initial	The initial value
 		// ==============================================================================
-		TLS( type initial ) : initialValue(initial) {
-			/*if ( !index.IsValid() ) 
-				User::Error("TLS allocation failed");*/
+		TLS( type initial ) : initialValue(initial), slot(TLS_Data::AllocSlot()) {
+			OG_ASSERT( slot != -1 );
 		}
 
 		// ==============================================================================
 		//! Default constructor
 		// ==============================================================================
-		TLS() {
-			/*if ( !index.IsValid() ) 
-				User::Error("TLS allocation failed");*/
+		TLS() : slot(TLS_Data::AllocSlot()) {
+			OG_ASSERT( slot != -1 );
 		}
 
 		// ==============================================================================
 		//! Get the thread local value
 		//!
-		//! @return	NULL if the TLS index was invalid
+		//! @return	NULL if no slot could be allocated
 		// ==============================================================================
 		type *Get( void ) const {
-			OG_ASSERT( index.IsValid() );
-			if ( index.IsValid() ) {
-				TLS_DataEx *data = static_cast<TLS_DataEx *>( index.GetValue() );
-				if ( data == OG_NULL )
-					data = new TLS_DataEx( &index, initialValue );
-				return &data->value;
-			}
-			return OG_NULL;
+			if ( slot == -1 )
+				return OG_NULL;
+			TLS_DataEx *data = static_cast<TLS_DataEx *>( TLS_Data::GetSlot( slot ) );
+			if ( data == OG_NULL )
+				data = new TLS_DataEx( slot, initialValue );
+			return &data->value;
 		}
 
 		// ==============================================================================
@@ -193,7 +216,7 @@ namespace og {
 
 	private:
 		type		initialValue;	//!< The initial value
-		TLS_Index	index;			//!< The TLS index
+		int			slot;			//!< The slot index
 	};
 	//! @}
 }
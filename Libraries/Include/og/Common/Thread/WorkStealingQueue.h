@@ -0,0 +1,159 @@
+// ==============================================================================
+//! @file
+//! @brief	Work Stealing Queue
+//! @author	David Chase, Yossi Lev: "Dynamic Circular Work-Stealing Deque" (SPAA 2005)
+//! @author	Santo Pfingsten (TTK-Bandit)
+//! @note	Copyright (C) 2007-2010 Lusito Software
+// ==============================================================================
+//
+// The Open Game Libraries.
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// ==============================================================================
+
+#ifndef __OG_WORK_STEALING_QUEUE_H__
+#define __OG_WORK_STEALING_QUEUE_H__
+
+#include <og/Common/Thread/Atomic.h>
+
+//! Open Game Libraries
+namespace og {
+//! @defgroup Common Common (Library)
+//! @{
+
+	// ==============================================================================
+	//! Lock free work stealing queue ( single owner, multiple thieves )
+	//!
+	//! The owner thread pushes and pops at the bottom ( LIFO ),
+	//! all other threads may steal from the top ( FIFO ).
+	//! The capacity is fixed, Push returns false once it's full.
+	// ==============================================================================
+	template<typename type>
+	class WorkStealingQueue {
+	public:
+		// ==============================================================================
+		//! Constructor
+		//!
+		//! @param	size	The maximum number of elements ( gets rounded up to a power of two )
+		// ==============================================================================
+		WorkStealingQueue( int size=1024 ) : top(0), bottom(0) {
+			int capacity = 2;
+			while( capacity < size )
+				capacity <<= 1;
+			mask = capacity - 1;
+			list = new type *[capacity];
+		}
+
+		// ==============================================================================
+		//! Destructor
+		// ==============================================================================
+		~WorkStealingQueue() { delete[] list; }
+
+		// ==============================================================================
+		//! Get the approximate number of entries
+		//!
+		//! @return	The number of entries, might be outdated as soon as it returns
+		// ==============================================================================
+		int		Num( void ) const {
+			int num = Distance( top, bottom );
+			return num > 0 ? num : 0;
+		}
+
+		// ==============================================================================
+		//! Add an entry to the bottom of the queue ( owner only )
+		//!
+		//! @param	data	A pointer to the object
+		//!
+		//! @return	false if the queue is full
+		// ==============================================================================
+		bool	Push( type *data ) {
+			int b = bottom;
+			if ( Distance( top, b ) > mask )
+				return false;
+			list[b & mask] = data;
+			AtomicFence();
+			bottom = b + 1;
+			return true;
+		}
+
+		// ==============================================================================
+		//! Get the newest entry and remove it from the queue ( owner only )
+		//!
+		//! @return	NULL if the queue is empty, otherwise the newest entry
+		// ==============================================================================
+		type *	Pop( void ) {
+			int b = bottom - 1;
+			AtomicExchange( &bottom, b );
+			int t = top;
+			int num = Distance( t, b );
+			if ( num < 0 ) {
+				bottom = b + 1;
+				return OG_NULL;
+			}
+			type *data = list[b & mask];
+			if ( num > 0 )
+				return data;
+
+			// last entry, race against the thieves
+			if ( AtomicCompareExchange( &top, t + 1, t ) != t )
+				data = OG_NULL;
+			bottom = t + 1;
+			return data;
+		}
+
+		// ==============================================================================
+		//! Get the oldest entry and remove it from the queue ( any thread )
+		//!
+		//! @return	NULL if the queue is empty or another thread was faster
+		// ==============================================================================
+		type *	Steal( void ) {
+			int t = top;
+			AtomicFence();
+			int b = bottom;
+			if ( Distance( t, b ) <= 0 )
+				return OG_NULL;
+			type *data = list[t & mask];
+			if ( AtomicCompareExchange( &top, t + 1, t ) != t )
+				return OG_NULL;
+			return data;
+		}
+
+	private:
+		// ==============================================================================
+		//! Distance between two indices, safe for wrap arounds
+		// ==============================================================================
+		static int	Distance( int from, int to ) {
+			return static_cast<int>( static_cast<uInt>(to) - static_cast<uInt>(from) );
+		}
+
+		volatile int	top;		//!< Next index to steal from
+		volatile int	bottom;		//!< Next index to push to
+		int				mask;		//!< capacity - 1
+		type * volatile *list;		//!< The ring buffer
+
+		// Not copyable
+		WorkStealingQueue( const WorkStealingQueue &other );
+		WorkStealingQueue &operator=( const WorkStealingQueue &other );
+	};
+
+	//! @}
+}
+
+#endif
@@ -38,6 +38,7 @@
 
 // Public Library Includes
 #include <og/Math/Random.h>
+#include <og/Math/RandomStream.h>
 #include <og/Math/Vector.h>
 #include <og/Math/Rectangle.h>
 #include <og/Math/Matrix.h>
@@ -49,6 +50,7 @@
 
 // We include .inl files last, so we can access all classes here.
 #include <og/Math/Random.inl>
+#include <og/Math/RandomStream.inl>
 #include <og/Math/Vector.inl>
 #include <og/Math/Rectangle.inl>
 #include <og/Math/Matrix.inl>
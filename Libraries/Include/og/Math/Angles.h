@@ -114,6 +114,8 @@ namespace og {
 		extern Angles roll;
 		extern Angles one;
 	}
+
+	OG_RELOCATABLE( Angles );
 }
 
 #endif
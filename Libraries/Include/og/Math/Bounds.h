@@ -81,6 +81,8 @@ namespace og {
 		bool			operator==(	const Bounds &a ) const;
 		bool			operator!=(	const Bounds &a ) const;
 	};
+
+	OG_RELOCATABLE( Bounds );
 }
 
 #endif
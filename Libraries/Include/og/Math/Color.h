@@ -116,6 +116,8 @@ namespace og {
 		extern Color pink;
 		extern Color brown;
 	}
+
+	OG_RELOCATABLE( Color );
 }
 
 #endif
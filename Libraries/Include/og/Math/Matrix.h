@@ -176,6 +176,9 @@ namespace og {
 		extern Mat3 zero;
 		extern Mat3 identity;
 	}
+
+	OG_RELOCATABLE( Mat2 );
+	OG_RELOCATABLE( Mat3 );
 }
 
 #endif
@@ -108,6 +108,8 @@ namespace og {
 		extern Quat zero;
 		extern Quat identity;
 	}
+
+	OG_RELOCATABLE( Quat );
 }
 
 #endif
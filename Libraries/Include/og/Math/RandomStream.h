@@ -0,0 +1,130 @@
+/*
+===========================================================================
+The Open Game Libraries.
+Copyright (C) 2007-2010 Lusito Software
+
+Author:  Santo Pfingsten (TTK-Bandit)
+Purpose: Small random number streams ( PCG32 and xoshiro128** )
+-----------------------------------------
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+===========================================================================
+*/
+
+#ifndef __OG_RANDOM_STREAM_H__
+#define __OG_RANDOM_STREAM_H__
+
+namespace og {
+	/*
+	==============================================================================
+
+	  RandomStream
+
+	  Common methods of the small generators below, they only need to implement
+	  uInt RandomUInt( void ). Unlike Random, these have just a few bytes of state,
+	  so give every thread or job its own stream instead of sharing one.
+
+	==============================================================================
+	*/
+	template<class T>
+	class RandomStream {
+	public:
+		int					RandomInt( int min, int max );		// random integer in the range [min, max]
+		bool				RandomBool( void );					// random boolean value [false, true]
+		float				RandomFloat( void );				// random number in the range [0.0f, 1.0f)
+		float				RandomFloat( float min, float max );// random number in the range [min, max)
+		float				SymmetricRandom( void );			// random number in the range [-1.0f, 1.0f)
+
+		// Fill arrays, the state is kept in registers for the whole loop
+		void				FillUInts( uInt *dest, int num );
+		void				FillInts( int *dest, int num, int min, int max );
+		void				FillFloats( float *dest, int num );
+		void				FillFloats( float *dest, int num, float min, float max );
+
+		static int			ToInt( uInt value, int min, int max );
+		static float		ToFloat( uInt value );
+
+	private:
+		T &					Self( void ) { return *static_cast<T *>(this); }
+	};
+
+	/*
+	==============================================================================
+
+	  RandomPCG
+
+	  PCG32 by Melissa O'Neill ( pcg-random.org ), 16 bytes of state.
+	  Every stream id selects a different sequence and Advance() skips
+	  any number of steps in O(log n), so streams can be derived from a seed
+	  and a job/thread index without any shared state.
+
+	==============================================================================
+	*/
+	class RandomPCG : public RandomStream<RandomPCG> {
+	public:
+		RandomPCG() { SetSeed( 0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL ); }
+		RandomPCG( uLongLong seed, uLongLong stream=0 ) { SetSeed( seed, stream ); }
+
+		void				SetSeed( uLongLong seed, uLongLong stream=0 );
+		void				SeedTime( uLongLong stream=0 );		// Sets the seed at ostime of calling function
+
+		uInt				RandomUInt( void );					// random uInt in the range [0,0xffffffff]
+
+		void				Advance( uLongLong delta );			// skip delta numbers
+		RandomPCG			Split( void );						// a new generator on a different stream, seeded by this one
+
+	private:
+		uLongLong			state;
+		uLongLong			increment;	// selects the stream, always odd
+	};
+
+	/*
+	==============================================================================
+
+	  RandomXoshiro
+
+	  xoshiro128** by David Blackman and Sebastiano Vigna ( prng.di.unimi.it ),
+	  16 bytes of state, 32bit operations only.
+	  Jump() skips 2^64 numbers, so Split() hands out non-overlapping streams
+	  for up to 2^64 jobs with 2^64 numbers each.
+
+	==============================================================================
+	*/
+	class RandomXoshiro : public RandomStream<RandomXoshiro> {
+	public:
+		RandomXoshiro() { SetSeed( 0 ); }
+		RandomXoshiro( uLongLong seed ) { SetSeed( seed ); }
+
+		void				SetSeed( uLongLong seed );
+		void				SeedTime( void );					// Sets the seed at ostime of calling function
+
+		uInt				RandomUInt( void );					// random uInt in the range [0,0xffffffff]
+
+		void				Jump( void );						// skip 2^64 numbers
+		void				LongJump( void );					// skip 2^96 numbers
+		RandomXoshiro		Split( void );						// returns a copy of this generator, then jumps this one
+
+	private:
+		void				JumpBy( const uInt *table );
+
+		uInt				s[4];
+	};
+}
+
+#endif
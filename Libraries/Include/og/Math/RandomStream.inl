@@ -0,0 +1,239 @@
+/*
+===========================================================================
+The Open Game Libraries.
+Copyright (C) 2007-2010 Lusito Software
+
+Author:  Santo Pfingsten (TTK-Bandit)
+Purpose: Small random number streams ( PCG32 and xoshiro128** )
+-----------------------------------------
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+===========================================================================
+*/
+
+#ifndef __OG_RANDOM_STREAM_INL__
+#define __OG_RANDOM_STREAM_INL__
+
+namespace og {
+
+/*
+==============================================================================
+
+  RandomStream
+
+==============================================================================
+*/
+
+/*
+================
+RandomStream::ToInt
+
+Maps the full 32bit range onto [min, max] with a multiply instead of a modulo.
+Done in unsigned arithmetic, so wide ranges like [INT_MIN, INT_MAX] can't overflow.
+================
+*/
+template<class T>
+OG_INLINE int RandomStream<T>::ToInt( uInt value, int min, int max ) {
+	uInt range = static_cast<uInt>(max) - static_cast<uInt>(min) + 1;
+	if ( range == 0 )
+		return static_cast<int>(value);
+	uInt offset = static_cast<uInt>( (static_cast<uLongLong>(value) * range) >> 32 );
+	return static_cast<int>( static_cast<uInt>(min) + offset );
+}
+
+/*
+================
+RandomStream::ToFloat
+
+Uses the upper 24 bits, all of them fit into the mantissa
+================
+*/
+template<class T>
+OG_INLINE float RandomStream<T>::ToFloat( uInt value ) {
+	return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+}
+
+/*
+================
+RandomStream::RandomInt
+================
+*/
+template<class T>
+OG_INLINE int RandomStream<T>::RandomInt( int min, int max ) {
+	return ToInt( Self().RandomUInt(), min, max );
+}
+
+/*
+================
+RandomStream::RandomBool
+================
+*/
+template<class T>
+OG_INLINE bool RandomStream<T>::RandomBool( void ) {
+	return (Self().RandomUInt() >> 31) != 0;
+}
+
+/*
+================
+RandomStream::RandomFloat
+================
+*/
+template<class T>
+OG_INLINE float RandomStream<T>::RandomFloat( void ) {
+	return ToFloat( Self().RandomUInt() );
+}
+template<class T>
+OG_INLINE float RandomStream<T>::RandomFloat( float min, float max ) {
+	return min + (max - min) * ToFloat( Self().RandomUInt() );
+}
+
+/*
+================
+RandomStream::SymmetricRandom
+================
+*/
+template<class T>
+OG_INLINE float RandomStream<T>::SymmetricRandom( void ) {
+	return 2.0f * ToFloat( Self().RandomUInt() ) - 1.0f;
+}
+
+/*
+================
+RandomStream::FillUInts
+
+Works on a local copy, so the compiler does not have to
+assume the stores into dest could change the state
+================
+*/
+template<class T>
+void RandomStream<T>::FillUInts( uInt *dest, int num ) {
+	T gen = Self();
+	for( int i=0; i<num; i++ )
+		dest[i] = gen.RandomUInt();
+	Self() = gen;
+}
+
+/*
+================
+RandomStream::FillInts
+================
+*/
+template<class T>
+void RandomStream<T>::FillInts( int *dest, int num, int min, int max ) {
+	T gen = Self();
+	for( int i=0; i<num; i++ )
+		dest[i] = ToInt( gen.RandomUInt(), min, max );
+	Self() = gen;
+}
+
+/*
+================
+RandomStream::FillFloats
+================
+*/
+template<class T>
+void RandomStream<T>::FillFloats( float *dest, int num ) {
+	T gen = Self();
+	for( int i=0; i<num; i++ )
+		dest[i] = ToFloat( gen.RandomUInt() );
+	Self() = gen;
+}
+template<class T>
+void RandomStream<T>::FillFloats( float *dest, int num, float min, float max ) {
+	T gen = Self();
+	float scale = max - min;
+	for( int i=0; i<num; i++ )
+		dest[i] = min + scale * ToFloat( gen.RandomUInt() );
+	Self() = gen;
+}
+
+/*
+==============================================================================
+
+  RandomPCG
+
+==============================================================================
+*/
+const uLongLong PCG_MULTIPLIER = 6364136223846793005ULL;
+
+/*
+================
+RandomPCG::RandomUInt
+================
+*/
+OG_INLINE uInt RandomPCG::RandomUInt( void ) {
+	uLongLong old = state;
+	state = old * PCG_MULTIPLIER + increment;
+	uInt xorShifted = static_cast<uInt>( ((old >> 18) ^ old) >> 27 );
+	uInt rot = static_cast<uInt>( old >> 59 );
+	return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+}
+
+/*
+================
+RandomPCG::Split
+================
+*/
+OG_INLINE RandomPCG RandomPCG::Split( void ) {
+	uLongLong seed = (static_cast<uLongLong>(RandomUInt()) << 32) | RandomUInt();
+	uLongLong stream = (static_cast<uLongLong>(RandomUInt()) << 32) | RandomUInt();
+	return RandomPCG( seed, stream );
+}
+
+/*
+==============================================================================
+
+  RandomXoshiro
+
+==============================================================================
+*/
+
+/*
+================
+RandomXoshiro::RandomUInt
+================
+*/
+OG_INLINE uInt RandomXoshiro::RandomUInt( void ) {
+	uInt x = s[1] * 5;
+	uInt result = ((x << 7) | (x >> 25)) * 9;
+	uInt t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 11) | (s[3] >> 21);
+	return result;
+}
+
+/*
+================
+RandomXoshiro::Split
+================
+*/
+OG_INLINE RandomXoshiro RandomXoshiro::Split( void ) {
+	RandomXoshiro result = *this;
+	Jump();
+	return result;
+}
+
+}
+
+#endif
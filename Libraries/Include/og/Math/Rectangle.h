@@ -67,6 +67,8 @@ namespace og {
 
 		Rect &			operator=( const Rect &rect );
 	};
+
+	OG_RELOCATABLE( Rect );
 }
 
 #endif
@@ -409,6 +409,11 @@ namespace og {
 		VecX<dim>		operator+( const VecX<dim> &vec ) const;
 		VecX<dim>		operator-( const VecX<dim> &vec ) const;
 	};
+
+	OG_RELOCATABLE( Vec2 );
+	OG_RELOCATABLE( Vec3 );
+	OG_RELOCATABLE( Vec4 );
+	OG_RELOCATABLE( Vec5 );
 }
 
 #endif
@@ -253,6 +253,40 @@ namespace og {
 		ptr = OG_NULL;
 	}
 
+	// ==============================================================================
+	//! Check if objects of a type can be moved around in memory with memcpy
+	//!
+	//! Containers use this to move items bitwise when they need to resize, rather than
+	//! copying and destroying them one by one. Types which point into themselves
+	//! ( like String ) must not be marked.
+	//!
+	//! @see	OG_RELOCATABLE
+	// ==============================================================================
+	template<class T>
+	struct IsRelocatable { static const bool value = false; };
+	template<class T>
+	struct IsRelocatable<T *> { static const bool value = true; };
+
+	// ==============================================================================
+	//! Mark a type as relocatable ( use within namespace og )
+	// ==============================================================================
+#define OG_RELOCATABLE( type ) template<> struct IsRelocatable<type> { static const bool value = true; }
+
+	OG_RELOCATABLE( bool );
+	OG_RELOCATABLE( char );
+	OG_RELOCATABLE( signed char );
+	OG_RELOCATABLE( unsigned char );
+	OG_RELOCATABLE( short );
+	OG_RELOCATABLE( unsigned short );
+	OG_RELOCATABLE( int );
+	OG_RELOCATABLE( unsigned int );
+	OG_RELOCATABLE( long );
+	OG_RELOCATABLE( unsigned long );
+	OG_RELOCATABLE( long long );
+	OG_RELOCATABLE( unsigned long long );
+	OG_RELOCATABLE( float );
+	OG_RELOCATABLE( double );
+
 //! @}
 }
 
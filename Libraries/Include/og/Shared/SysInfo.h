@@ -207,6 +207,27 @@ namespace og {
 						WDT				: 1; //!< Watchdog timer support
 			} AMD_extended;
 		};
+
+		// ==============================================================================
+		//! Processor topology as reported by the operating system
+		//!
+		//! Logical processor i is bit i in an affinity mask.
+		//! The process may be restricted to a subset of them ( see usable ),
+		//! only those should be used for pinning threads.
+		// ==============================================================================
+		class Topology {
+		public:
+			static const int MAX_LOGICAL = 64;	//!< Processors beyond this are ignored
+
+			int			numLogical;				//!< Number of logical processors ( hardware threads )
+			int			numCores;				//!< Number of physical cores
+			int			numNodes;				//!< Number of NUMA nodes
+			int			core[MAX_LOGICAL];		//!< The core of every logical processor ( 0 to numCores-1 )
+			int			node[MAX_LOGICAL];		//!< The NUMA node of every logical processor ( 0 to numNodes-1 )
+			uLongLong	usable;					//!< Affinity mask of the logical processors this process may run on
+			int			numUsable;				//!< Number of logical processors in usable
+			int			numUsableCores;			//!< Number of physical cores with at least one processor in usable
+		};
 	}
 
 	// ==============================================================================
@@ -254,6 +275,7 @@ namespace og {
 		bool		GetOSInfo( OSInfo &data );
 
 		extern CPU::Features	cpu;	//!< CPU information
+		extern CPU::Topology	topology;	//!< Processor topology
 		extern uLongLong		ramB;	//!< Available RAM in bytes
 		extern uLongLong		ramMB;	//!< Available RAM in megabytes
 	};
@@ -34,232 +34,121 @@ namespace og {
 /*
 ==============================================================================
 
-  EE_Base
+  AudioCommandHandler
 
 ==============================================================================
 */
-class EE_Base : public QueuedEvent {
-public:
-	EE_Base( AudioEmitterEx *emt ) : emitter(emt) {}
-
-protected:
-	AudioEmitterEx *emitter;
-};
-
 /*
-==============================================================================
-
-  EE_Play
-
-==============================================================================
+================
+AudioCommandHandler::operator()
+================
 */
-class EE_Play : public EE_Base {
-public:
-	EE_Play( AudioEmitterEx *emt, int ch, const Sound *snd, bool loopAllowed )
-		: EE_Base(emt), channel(ch), sound(snd), allowLoop(loopAllowed) {}
-
-	void	Execute( void )  {
-		ogst::unique_lock<ogst::mutex> lock(emitter->mutex);
-		if ( emitter->IsValidChannel( channel ) ) {
-			AudioSource *source = emitter->sndChannels[channel];
-			if ( source == OG_NULL )
-				source = audioSystemObject.audioThread->FindFreeAudioSource();
-
-			if ( source ) {
-				if ( source->Play( emitter, channel, sound, allowLoop ) ) {
-					emitter->sndChannels[channel] = source;
-					emitter->sndChannels[channel]->OnUpdate( &emitter->details );
+void AudioCommandHandler::operator()( const AudioCommand &cmd ) {
+	AudioEmitterEx *emitter = cmd.emitter;
+	switch( cmd.type ) {
+		case AC_PLAY: {
+			ogst::unique_lock<ogst::mutex> lock(emitter->mutex);
+			if ( emitter->IsValidChannel( cmd.channel ) ) {
+				AudioSource *source = emitter->sndChannels[cmd.channel];
+				if ( source == OG_NULL )
+					source = audioSystemObject.audioThread->FindFreeAudioSource();
+
+				if ( source ) {
+					if ( source->Play( emitter, cmd.channel, cmd.sound, cmd.flag ) ) {
+						emitter->sndChannels[cmd.channel] = source;
+						emitter->sndChannels[cmd.channel]->OnUpdate( &emitter->details );
+					}
+					break;
 				}
-				return;
+				User::Warning("No more free sound Sources!");
 			}
-			User::Warning("No more free sound Sources!");
+			break;
 		}
-	}
-
-private:
-	int channel;
-	const Sound *sound;
-	bool allowLoop;
-};
-
-/*
-==============================================================================
-
-  EE_Pause
-
-==============================================================================
-*/
-class EE_Pause : public EE_Base {
-public:
-	EE_Pause( AudioEmitterEx *emt, int ch ) : EE_Base(emt), channel(ch) {}
-
-	void	Execute( void )  {
-		emitter->mutex.lock();
-		if ( emitter->IsValidChannel( channel ) && emitter->sndChannels[channel] != OG_NULL )
-			emitter->sndChannels[channel]->Pause();
-		emitter->mutex.unlock();
-	}
-
-private:
-	int channel;
-};
-
-/*
-==============================================================================
-
-  EE_Stop
-
-==============================================================================
-*/
-class EE_Stop : public EE_Base {
-public:
-	EE_Stop( AudioEmitterEx *emt, int ch ) : EE_Base(emt), channel(ch) {}
-
-	void	Execute( void )  {
-		emitter->mutex.lock();
-		if ( channel == -1 ) {
-			for( int i=0; i<emitter->numChannels; i++ ) {
-				if ( emitter->sndChannels[i] != OG_NULL )
-					emitter->sndChannels[i]->Stop();
+		case AC_PAUSE:
+			emitter->mutex.lock();
+			if ( emitter->IsValidChannel( cmd.channel ) && emitter->sndChannels[cmd.channel] != OG_NULL )
+				emitter->sndChannels[cmd.channel]->Pause();
+			emitter->mutex.unlock();
+			break;
+		case AC_STOP:
+			emitter->mutex.lock();
+			if ( cmd.channel == -1 ) {
+				for( int i=0; i<emitter->numChannels; i++ ) {
+					if ( emitter->sndChannels[i] != OG_NULL )
+						emitter->sndChannels[i]->Stop();
+				}
 			}
-		}
-		else if ( emitter->IsValidChannel( channel ) && emitter->sndChannels[channel] != OG_NULL )
-			emitter->sndChannels[channel]->Stop();
-		emitter->mutex.unlock();
-	}
-
-private:
-	int channel;
-};
-
-/*
-==============================================================================
-
-  EE_Update
-
-==============================================================================
-*/
-class EE_Update : public EE_Base {
-public:
-	EE_Update( AudioEmitterEx *emt ) : EE_Base(emt) {}
-
-	void	Update( void )  {
-		emitter->mutex.lock();
-		if ( emitter->IsValidChannel( 0 ) ) {
-			for( int i=0; i<emitter->numChannels; i++ ) {
-				if ( emitter->sndChannels[i] != OG_NULL )
-					emitter->sndChannels[i]->OnUpdate( &emitter->details );
+			else if ( emitter->IsValidChannel( cmd.channel ) && emitter->sndChannels[cmd.channel] != OG_NULL )
+				emitter->sndChannels[cmd.channel]->Stop();
+			emitter->mutex.unlock();
+			break;
+		case AC_SET_RELATIVE:
+			emitter->details.relative = cmd.flag;
+			MarkChanged( emitter );
+			break;
+		case AC_SET_POSITION:
+			emitter->details.origin = cmd.vec;
+			MarkChanged( emitter );
+			break;
+		case AC_SET_VELOCITY:
+			emitter->details.velocity = cmd.vec;
+			MarkChanged( emitter );
+			break;
+		case AC_SET_DIRECTIONAL:
+			emitter->details.direction = cmd.vec;
+			emitter->details.innerAngle = cmd.innerAngle;
+			emitter->details.outerAngle = cmd.outerAngle;
+			emitter->details.outerVolume = cmd.outerVolume;
+			MarkChanged( emitter );
+			break;
+		case AC_SET_EFFECT:
+			emitter->mutex.lock();
+			emitter->effect = cmd.effect;
+			if ( emitter->IsValidChannel( 0 ) ) {
+				for( int i=0; i<emitter->numChannels; i++ ) {
+					if ( emitter->sndChannels[i] != OG_NULL )
+						emitter->sndChannels[i]->SetEffect( cmd.effect );
+				}
 			}
-		}
-		emitter->mutex.unlock();
+			emitter->mutex.unlock();
+			break;
 	}
-};
-
-/*
-==============================================================================
-
-  EE_SetRelative
-
-==============================================================================
-*/
-class EE_SetRelative : public EE_Update {
-public:
-	EE_SetRelative( AudioEmitterEx *emt, bool val ) : EE_Update(emt), value(val) {}
-
-	void	Execute( void )  { emitter->details.relative = value; Update(); }
-
-private:
-	bool	value;
-};
-
-/*
-==============================================================================
-
-  EE_SetPosition
-
-==============================================================================
-*/
-class EE_SetPosition : public EE_Update {
-public:
-	EE_SetPosition( AudioEmitterEx *emt, const Vec3 &val ) : EE_Update(emt), value(val) {}
-
-	void	Execute( void )  { emitter->details.origin = value; Update(); }
-
-private:
-	Vec3	value;
-};
-
-/*
-==============================================================================
-
-  EE_SetVelocity
-
-==============================================================================
-*/
-class EE_SetVelocity : public EE_Update {
-public:
-	EE_SetVelocity( AudioEmitterEx *emt, const Vec3 &val ) : EE_Update(emt), value(val) {}
-
-	void	Execute( void )  { emitter->details.velocity = value; Update(); }
-
-private:
-	Vec3	value;
-};
+}
 
 /*
-==============================================================================
-
-  EE_SetDirectional
-
-==============================================================================
+================
+AudioCommandHandler::MarkChanged
+================
 */
-class EE_SetDirectional : public EE_Update {
-public:
-	EE_SetDirectional( AudioEmitterEx *emt, const Vec3 &dir, float innerAng, float outerAng, float outerVol )
-		: EE_Update(emt), direction(dir), innerAngle(innerAng), outerAngle(outerAng), outerVolume(outerVol) {}
-
-	void	Execute( void )  {
-		emitter->details.direction = direction;
-		emitter->details.innerAngle = innerAngle;
-		emitter->details.outerAngle = outerAngle;
-		emitter->details.outerVolume = outerVolume;
-		Update();
+void AudioCommandHandler::MarkChanged( AudioEmitterEx *emitter ) {
+	if ( !emitter->detailsChanged ) {
+		emitter->detailsChanged = true;
+		emitter->nextChanged = firstChanged;
+		firstChanged = emitter;
 	}
-
-private:
-	Vec3	direction;
-	float	innerAngle;
-	float	outerAngle;
-	float	outerVolume;
-};
+}
 
 /*
-==============================================================================
-
-  EE_SetEffect
-
-==============================================================================
+================
+AudioCommandHandler::Flush
+================
 */
-class EE_SetEffect : public EE_Base {
-public:
-	EE_SetEffect( AudioEmitterEx *emt, AudioEffectEx *fx )
-		: EE_Base(emt), effect(fx) {}
-
-	void	Execute( void )  {
+void AudioCommandHandler::Flush( void ) {
+	while( firstChanged != OG_NULL ) {
+		AudioEmitterEx *emitter = firstChanged;
+		firstChanged = emitter->nextChanged;
+		emitter->detailsChanged = false;
+		emitter->nextChanged = OG_NULL;
 		emitter->mutex.lock();
-		emitter->effect = effect;
 		if ( emitter->IsValidChannel( 0 ) ) {
-			for( int i=0; i<emitter->numChannels; i++ ) {
-				if ( emitter->sndChannels[i] != OG_NULL )
-					emitter->sndChannels[i]->SetEffect( effect );
+			for( int j=0; j<emitter->numChannels; j++ ) {
+				if ( emitter->sndChannels[j] != OG_NULL )
+					emitter->sndChannels[j]->OnUpdate( &emitter->details );
 			}
 		}
 		emitter->mutex.unlock();
 	}
-
-private:
-	AudioEffectEx *effect;
-};
+}
 
 /*
 ==============================================================================
@@ -278,6 +167,8 @@ AudioEmitterEx::AudioEmitterEx() {
 	sndChannels = OG_NULL;
 	numChannels = 0;
 	effect = OG_NULL;
+	detailsChanged = false;
+	nextChanged = OG_NULL;
 	details.relative	= false;
 	details.innerAngle	= 360.0f;
 	details.outerAngle	= 360.0f;
@@ -348,14 +239,30 @@ bool AudioEmitterEx::IsValidChannel( int channel ) const {
 	return true;
 }
 
+/*
+================
+AudioEmitterEx::SendCommand
+================
+*/
+void AudioEmitterEx::SendCommand( AudioCommand &cmd, AudioCommandType type ) {
+	if ( audioSystemObject.audioThread ) {
+		cmd.type = type;
+		cmd.emitter = this;
+		audioSystemObject.audioThread->AddCommand( cmd );
+	}
+}
+
 /*
 ================
 AudioEmitterEx::Play
 ================
 */
 void AudioEmitterEx::Play( int channel, const Sound *sound, bool allowLoop ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_Play( this, channel, sound, allowLoop ) );
+	AudioCommand cmd;
+	cmd.channel = channel;
+	cmd.sound = sound;
+	cmd.flag = allowLoop;
+	SendCommand( cmd, AC_PLAY );
 }
 
 /*
@@ -364,8 +271,9 @@ AudioEmitterEx::Stop
 ================
 */
 void AudioEmitterEx::Stop( int channel ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_Stop( this, channel ) );
+	AudioCommand cmd;
+	cmd.channel = channel;
+	SendCommand( cmd, AC_STOP );
 }
 
 /*
@@ -374,8 +282,9 @@ AudioEmitterEx::StopAll
 ================
 */
 void AudioEmitterEx::StopAll( void ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_Stop( this, -1 ) );
+	AudioCommand cmd;
+	cmd.channel = -1;
+	SendCommand( cmd, AC_STOP );
 }
 
 /*
@@ -384,8 +293,9 @@ AudioEmitterEx::Pause
 ================
 */
 void AudioEmitterEx::Pause( int channel ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_Pause( this, channel ) );
+	AudioCommand cmd;
+	cmd.channel = channel;
+	SendCommand( cmd, AC_PAUSE );
 }
 
 /*
@@ -403,8 +313,9 @@ AudioEmitterEx::SetRelative
 ================
 */
 void AudioEmitterEx::SetRelative( bool value ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_SetRelative( this, value ) );
+	AudioCommand cmd;
+	cmd.flag = value;
+	SendCommand( cmd, AC_SET_RELATIVE );
 }
 
 /*
@@ -413,8 +324,9 @@ AudioEmitterEx::SetPosition
 ================
 */
 void AudioEmitterEx::SetPosition( const Vec3 &pos ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_SetPosition( this, pos ) );
+	AudioCommand cmd;
+	cmd.vec = pos;
+	SendCommand( cmd, AC_SET_POSITION );
 }
 
 /*
@@ -423,8 +335,9 @@ AudioEmitterEx::SetVelocity
 ================
 */
 void AudioEmitterEx::SetVelocity( const Vec3 &vel ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_SetVelocity( this, vel ) );
+	AudioCommand cmd;
+	cmd.vec = vel;
+	SendCommand( cmd, AC_SET_VELOCITY );
 }
 
 /*
@@ -433,8 +346,12 @@ AudioEmitterEx::SetDirectional
 ================
 */
 void AudioEmitterEx::SetDirectional( const Vec3 &dir, float innerAngle, float outerAngle, float outerVolume ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_SetDirectional( this, dir, innerAngle, outerAngle, outerVolume ) );
+	AudioCommand cmd;
+	cmd.vec = dir;
+	cmd.innerAngle = innerAngle;
+	cmd.outerAngle = outerAngle;
+	cmd.outerVolume = outerVolume;
+	SendCommand( cmd, AC_SET_DIRECTIONAL );
 }
 
 /*
@@ -443,8 +360,9 @@ AudioEmitterEx::SetEffect
 ================
 */
 void AudioEmitterEx::SetEffect( AudioEffect *effect ) {
-	if ( audioSystemObject.audioThread )
-		audioSystemObject.audioThread->AddEvent( new EE_SetEffect( this, static_cast<AudioEffectEx *>(effect) ) );
+	AudioCommand cmd;
+	cmd.effect = static_cast<AudioEffectEx *>(effect);
+	SendCommand( cmd, AC_SET_EFFECT );
 }
 
 }
@@ -31,6 +31,57 @@
 #define __OG_AUDIO_EMITTER_EX_H__
 
 namespace og {
+	class AudioEmitterEx;
+
+	enum AudioCommandType {
+		AC_PLAY,
+		AC_PAUSE,
+		AC_STOP,
+		AC_SET_RELATIVE,
+		AC_SET_POSITION,
+		AC_SET_VELOCITY,
+		AC_SET_DIRECTIONAL,
+		AC_SET_EFFECT
+	};
+
+	// A plain command record, sent from the emitter to the audio thread
+	struct AudioCommand {
+		AudioCommandType	type;
+		AudioEmitterEx *	emitter;
+		int					channel;	// AC_PLAY, AC_PAUSE, AC_STOP ( -1 = all channels )
+		bool				flag;		// AC_PLAY: allowLoop, AC_SET_RELATIVE: value
+		const Sound *		sound;		// AC_PLAY
+		AudioEffectEx *		effect;		// AC_SET_EFFECT
+		Vec3				vec;		// AC_SET_POSITION, AC_SET_VELOCITY, AC_SET_DIRECTIONAL
+		float				innerAngle;	// AC_SET_DIRECTIONAL
+		float				outerAngle;	// AC_SET_DIRECTIONAL
+		float				outerVolume;// AC_SET_DIRECTIONAL
+	};
+
+	/*
+	==============================================================================
+
+	  AudioCommandHandler
+
+	  Executes AudioCommands on the audio thread.
+	  Changes to the source setup only mark the emitter, Flush() then passes the
+	  final setup to the sources, so the last position/velocity of a batch wins.
+
+	==============================================================================
+	*/
+	class AudioCommandHandler {
+	public:
+		AudioCommandHandler() : firstChanged(OG_NULL) {}
+
+		void	operator()( const AudioCommand &cmd );
+		void	Flush( void );
+
+	private:
+		void	MarkChanged( AudioEmitterEx *emitter );
+
+		AudioEmitterEx *firstChanged;
+	};
+
 	/*
 	==============================================================================
 
@@ -68,25 +119,20 @@ namespace og {
 		void	OnSourceStop( int channel );
 
 	private:
-		friend class EE_Play;
-		friend class EE_Pause;
-		friend class EE_Stop;
-		friend class EE_Update;
-		friend class EE_SetRelative;
-		friend class EE_SetPosition;
-		friend class EE_SetVelocity;
-		friend class EE_SetDirectional;
-		friend class EE_SetEffect;
+		friend class AudioCommandHandler;
 		friend class AudioSource;
 		friend class AudioSystemEx;
 
 		bool	IsValidChannel( int channel ) const;
+		void	SendCommand( AudioCommand &cmd, AudioCommandType type );
 
 		AudioSource **sndChannels;
 		int		numChannels;
 
 		AudioSourceSetup details;
 		AudioEffectEx *	effect;
+		bool			detailsChanged;	// Only touched by the audio thread
+		AudioEmitterEx *nextChanged;	// Only touched by the audio thread
 
 		ogst::mutex		mutex;
 		LinkedList<AudioEmitterEx>::nodeType *node;
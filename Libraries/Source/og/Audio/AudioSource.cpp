@@ -102,8 +102,7 @@ bool AudioSource::Play( AudioEmitterEx *_emitter, int channel, const Sound *soun
 		filename = sound->filenames[0].c_str();
 	else {
 		// Multiple sounds available, randomly choose one.
-		Random rnd;
-		filename = sound->filenames[ rnd.RandomInt(0, num-1) ].c_str();
+		filename = sound->filenames[ audioSystemObject.audioThread->random.RandomInt(0, num-1) ].c_str();
 	}
 
 	alSourcef( alSourceNum, AL_REFERENCE_DISTANCE, sound->minDistance );
@@ -172,6 +171,21 @@ void AudioSource::Frame( void ) {
 	}
 }
 
+/*
+================
+AudioSource::GetWakeUpDelay
+
+Returns the milliseconds until Frame() needs to be called again,
+-1 if it's not needed at all.
+================
+*/
+int AudioSource::GetWakeUpDelay( void ) const {
+	if ( !IsActive() )
+		return -1;
+	OG_ASSERT( streamData->stream );
+	return streamData->stream->GetWakeUpDelay( this );
+}
+
 /*
 ================
 AudioSource::OnUpdate
@@ -67,6 +67,7 @@ namespace og {
 		void	OnUpdate( const AudioSourceSetup *setup );
 
 		bool	IsActive( void ) const { return emitter != OG_NULL; }
+		int		GetWakeUpDelay( void ) const;
 
 		bool	SetEffect( AudioEffectEx *effect );
 
@@ -133,7 +133,7 @@ bool VorbisStream::LoadFile( const char *filename ) {
 	else
 		format = AL_FORMAT_STEREO16;
 	freq = fileInfo->rate;
-	outSize = freq * fileInfo->channels * 2;
+	bytesPerSecond = outSize = freq * fileInfo->channels * 2;
 
 	delete streamData;
 
@@ -356,6 +356,7 @@ bool WavStream::LoadFile( const char *filename ) {
 					file->Seek( 6, SEEK_CUR ); // AvgBytesPerSec(4), BlockAlign(2)
 
 					bitsPerSample = file->ReadUshort();
+					bytesPerSecond = freq * channels * (bitsPerSample / 8);
 
 					if ( channels == 1 )
 						format = (bitsPerSample == 8) ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
@@ -515,6 +516,40 @@ void AudioStream::UpdateStream( AudioSource *src ) {
 	return;
 }
 
+/*
+================
+AudioStream::GetWakeUpDelay
+
+Streams need a refill as soon as the current buffer is done,
+other sounds only need a check when they end.
+================
+*/
+int AudioStream::GetWakeUpDelay( const AudioSource *src ) const {
+	OG_ASSERT( src->streamData != OG_NULL );
+
+	ALint state;
+	alGetSourcei( src->alSourceNum, AL_SOURCE_STATE, &state );
+	if ( state != AL_PLAYING || bytesPerSecond == 0 )
+		return -1;
+
+	ALint offset;
+	alGetSourcei( src->alSourceNum, AL_BYTE_OFFSET, &offset );
+
+	uInt remaining;
+	if ( outSize > AUDIOSRC_STREAM_LIMIT ) {
+		// Processed buffers have been unqueued, so the offset starts at the current buffer
+		remaining = AUDIOSRC_BUFFERSIZE - static_cast<uInt>(offset) % AUDIOSRC_BUFFERSIZE;
+	} else {
+		// Looping is done by OpenAL
+		if ( src->streamData->loop )
+			return -1;
+		ALint size;
+		alGetBufferi( src->alBuffers[0], AL_SIZE, &size );
+		remaining = size > offset ? static_cast<uInt>(size - offset) : 0;
+	}
+	return static_cast<int>( remaining * 1000 / bytesPerSecond ) + 1;
+}
+
 /*
 ================
 AudioStream::Open
@@ -54,7 +54,7 @@ namespace og {
 	*/
 	class AudioStream {
 	public:
-		AudioStream() : numInUse(0), format(0), freq(0), data(OG_NULL), dataSize(0) {}
+		AudioStream() : numInUse(0), format(0), freq(0), bytesPerSecond(0), data(OG_NULL), dataSize(0) {}
 		virtual ~AudioStream() {}
 
 		virtual bool	LoadFile( const char *filename ) = 0;
@@ -67,6 +67,7 @@ namespace og {
 
 		bool			StartStream( AudioSource *src, bool loop );
 		void			UpdateStream( AudioSource *src );
+		int				GetWakeUpDelay( const AudioSource *src ) const;
 
 		static	AudioStream *Open( const char *filename );
 
@@ -77,6 +78,7 @@ namespace og {
 		int		numInUse;
 		uInt	format;
 		uInt	freq;
+		uInt	bytesPerSecond;
 
 		byte	*data;
 		uInt	dataSize;
@@ -39,6 +39,7 @@ AudioSystem *AS = &audioSystemObject;
 const int MAX_AUDIOSOURCES = 64;
 const int MAX_SAFE_LEVELS = 8;
 const float FOCUS_STEP = 0.05f;
+const int FOCUS_STEP_TIME = 20; // milliseconds between two focus steps
 
 /*
 ================
@@ -84,6 +85,8 @@ AudioThread::Run
 ================
 */
 void AudioThread::Run( void ) {
+	random.SeedTime();
+
 	AudioSource *source = OG_NULL;
 	uInt alSourceNum;
 	for( int i=0; i<MAX_AUDIOSOURCES; i++ ) {
@@ -100,34 +103,48 @@ void AudioThread::Run( void ) {
 	}*/
 	wakeUpEvent.Lock();
 	while( keepRunning ) {
-		eventQueue.ProcessAll();
+		AtomicExchange( &wakeUpPending, 0 );
+		ProcessCommands();
 
-		// update audio sources
+		// update audio sources and find the earliest time one of them needs us again
+		int delay = -1;
 		for( AudioSource *source = firstAudioSource; source != OG_NULL; source = source->next ) {
-			if ( source->IsActive() )
+			if ( source->IsActive() ) {
 				source->Frame();
+				int sourceDelay = source->GetWakeUpDelay();
+				if ( sourceDelay != -1 && (delay == -1 || sourceDelay < delay) )
+					delay = sourceDelay;
+			}
 		}
 
 		// do focus fading
+		bool fading = false;
 		if ( audioSystemObject.windowFocus && audioSystemObject.focusVolume != 1.0f ) {
 			audioSystemObject.focusVolume += FOCUS_STEP;
 			if ( audioSystemObject.focusVolume > 1.0f )
 				audioSystemObject.focusVolume = 1.0f;
 			audioSystemObject.SetVolume( audioSystemObject.volume );
+			fading = true;
 		} else if ( !audioSystemObject.windowFocus && audioSystemObject.focusVolume != 0.0f ) {
 			audioSystemObject.focusVolume -= FOCUS_STEP;
 			if ( audioSystemObject.focusVolume < 0.0f )
 				audioSystemObject.focusVolume = 0.0f;
 			audioSystemObject.SetVolume( audioSystemObject.volume );
+			fading = true;
 		}
-
-		// Wait for an event or 20ms passed
-		wakeUpEvent.Wait(20);
+		if ( fading && (delay == -1 || delay > FOCUS_STEP_TIME) )
+			delay = FOCUS_STEP_TIME;
+
+		// Wait for a command or the next deadline, if nothing is playing, commands are all we wait for
+		if ( delay == -1 )
+			wakeUpEvent.Wait();
+		else
+			wakeUpEvent.Wait( delay );
 	}
 	wakeUpEvent.Unlock();
 
-	// Consume remaining events
-	eventQueue.ProcessAll();
+	// Consume remaining commands
+	ProcessCommands();
 
 	SafeDelete( firstAudioSource );
 	SafeDelete( defaultStream );
@@ -138,6 +155,31 @@ void AudioThread::Run( void ) {
 	audioStreams.Clear();
 }
 
+/*
+================
+AudioThread::AddCommand
+================
+*/
+void AudioThread::AddCommand( const AudioCommand &cmd ) {
+	commands.Add( cmd );
+
+	// Only the first command after the thread went to sleep needs to wake it up.
+	// The fence keeps the command from being published after wakeUpPending has been read.
+	AtomicFence();
+	if ( wakeUpPending == 0 && AtomicExchange( &wakeUpPending, 1 ) == 0 )
+		WakeUp();
+}
+
+/*
+================
+AudioThread::ProcessCommands
+================
+*/
+void AudioThread::ProcessCommands( void ) {
+	commands.ProcessAll( commandHandler );
+	commandHandler.Flush();
+}
+
 /*
 ================
 AudioThread::FindFreeAudioSource
@@ -414,6 +456,10 @@ bool AudioSystem::Init( FileSystemCore *fileSystem, const char *defaultFilename,
 	return audioSystemObject.Init(defaultFilename, deviceName);
 }
 void AudioSystem::Shutdown( void )					{ audioSystemObject.Shutdown(); audioFS = OG_NULL; }
-void AudioSystem::SetWindowFocus( bool hasFocus )	{ audioSystemObject.windowFocus = hasFocus; }
+void AudioSystem::SetWindowFocus( bool hasFocus ) {
+	audioSystemObject.windowFocus = hasFocus;
+	if ( audioSystemObject.audioThread )
+		audioSystemObject.audioThread->WakeUp(); // start fading
+}
 
 }
@@ -53,19 +53,25 @@ namespace og {
 	*/
 	class AudioThread : public Thread {
 	public:
-		AudioThread( AudioStream *stream ) : firstAudioSource(OG_NULL), defaultStream(stream) {}
+		AudioThread( AudioStream *stream ) : wakeUpPending(0), firstAudioSource(OG_NULL), defaultStream(stream) {}
 
-		void	AddEvent( QueuedEvent *evt ) { eventQueue.Add( evt ); WakeUp(); }
+		void	AddCommand( const AudioCommand &cmd );
 
 		AudioSource *FindFreeAudioSource( void );
 
 		void	PlayStream( AudioSource *src, const char *filename, bool loop );
 
+		RandomPCG	random;	// For picking sound variations, only used by the audio thread
+
 	protected:
 		void	Run( void );
 
 	private:
-		EventQueue	eventQueue;
+		void	ProcessCommands( void );
+
+		EventBus<AudioCommand>	commands;
+		AudioCommandHandler		commandHandler;
+		volatile int			wakeUpPending;	// Set by the first command after the thread went to sleep
 		AudioSource *firstAudioSource;
 
 		AudioStream *defaultStream;
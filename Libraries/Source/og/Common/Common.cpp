@@ -62,7 +62,7 @@ public:
 
 	static int Compare(const void *a, const void *b, void *context) {
 		CompareWrapper *wrap = reinterpret_cast<CompareWrapper *>(context);
-		wrap->compare( wrap->context, a, b );
+		return wrap->compare( wrap->context, a, b );
 	}
 private:
 	void *context;
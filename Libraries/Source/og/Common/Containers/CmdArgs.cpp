@@ -46,7 +46,7 @@ CmdArgs::Argv
 */
 const char *CmdArgs::Argv( int i ) const {
 	OG_ASSERT( i>=0 && i<num );
-	return list[i]->c_str();
+	return list[i].c_str();
 }
 
 /*
@@ -67,7 +67,7 @@ void CmdArgs::Args( String &result, int start, int end, bool escape ) const {
 			if ( escape )
 				result += "\"";
 		}
-		result += list[i]->c_str();
+		result += list[i].c_str();
 		if ( i > 0 ) {
 			if ( escape )
 				result += "\"";
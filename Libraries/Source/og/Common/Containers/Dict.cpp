@@ -49,10 +49,8 @@ Dict::Clear
 */
 void Dict::Clear( void ) {
 	int num = entries.Num();
-	for( int i=0; i<num; i++ ) {
-		keyPool->Free(entries[i].key);
-		valuePool->Free(entries[i].value);
-	}
+	for( int i=0; i<num; i++ )
+		FreeEntry( i );
 	entries.Clear();
 	hashIndex.Clear();
 }
@@ -66,14 +64,21 @@ void Dict::Remove( const char *key ) {
 	int hash = hashIndex.GenerateKey( key, false );
 	for( int i=hashIndex.First(hash); i!=-1; i=hashIndex.Next() ) {
 		if ( entries[i].GetKey().Icmp( key ) == 0 ) {
-			keyPool->Free( entries[i].key );
-			valuePool->Free( entries[i].value );
+			FreeEntry( i );
 			entries.Remove( i );
 			hashIndex.Remove( hash, i );
 			return;
 		}
 	}
 }
+void Dict::Remove( const HashedKey &key ) {
+	int i = Find( key );
+	if ( i != -1 ) {
+		FreeEntry( i );
+		entries.Remove( i );
+		hashIndex.Remove( key.GetHash(), i );
+	}
+}
 
 /*
 ================
@@ -83,8 +88,16 @@ Dict::Copy
 void Dict::Copy( const Dict &other ) {
 	Clear();
 	int num = other.entries.Num();
-	for ( int i = 0; i < num; i++ )
-		Set( other.entries[i].key->c_str(), other.entries[i].value->c_str() );
+	for ( int i = 0; i < num; i++ ) {
+		// The keys are unique already, so skip the lookup Set would do
+		const KeyValue &otherKv = other.entries[i];
+		KeyValue kv;
+		kv.key = keyPool->Copy( otherKv.key );
+		kv.value = valuePool->Copy( otherKv.value );
+		kv.foldedKey = keyPool->Copy( otherKv.foldedKey );
+		hashIndex.Add( hashIndex.GenerateKey( kv.key->c_str(), false ), entries.Num() );
+		entries.Append( kv );
+	}
 }
 
 /*
@@ -111,17 +124,28 @@ void Dict::Set( const char *key, const char *value ) {
 
 	int i = Find( key );
 	if ( i == -1 ) {
-		KeyValue kv;
-		kv.key = keyPool->Alloc( key );
-		kv.value = valuePool->Alloc( value );
-		hashIndex.Add( hashIndex.GenerateKey( kv.key->c_str(), false ), entries.Num() );
-		entries.Append( kv );
+		String folded( key );
+		folded.ToLower();
+		AddEntry( hashIndex.GenerateKey( key, false ), key, folded.c_str(), value );
 	} else {
 		const PoolString *oldValue = entries[i].value;
 		entries[i].value = valuePool->Alloc( value );
 		valuePool->Free( oldValue );
 	}
 }
+void Dict::Set( const HashedKey &key, const char *value ) {
+	if ( key.IsEmpty() )
+		return;
+
+	int i = Find( key );
+	if ( i == -1 )
+		AddEntry( key.GetHash(), key.GetKey(), key.GetFolded().c_str(), value );
+	else {
+		const PoolString *oldValue = entries[i].value;
+		entries[i].value = valuePool->Alloc( value );
+		valuePool->Free( oldValue );
+	}
+}
 
 /*
 ================
@@ -134,6 +158,12 @@ StringType Dict::Get( const char *key, const char *defaultValue ) const {
 		return StringType( defaultValue );
 	return entries[index].GetValue();
 }
+StringType Dict::Get( const HashedKey &key, const char *defaultValue ) const {
+	int index = Find( key );
+	if ( index == -1 )
+		return StringType( defaultValue );
+	return entries[index].GetValue();
+}
 
 /*
 ================
@@ -152,6 +182,17 @@ int Dict::Find( const char *key ) const {
 
 	return -1;
 }
+int Dict::Find( const HashedKey &key ) const {
+	if ( key.IsEmpty() )
+		return -1;
+
+	for ( int i = hashIndex.First( key.GetHash() ); i != -1; i = hashIndex.Next() ) {
+		if ( key.Matches( *entries[i].foldedKey ) )
+			return i;
+	}
+
+	return -1;
+}
 
 /*
 ================
@@ -201,4 +242,29 @@ void Dict::WriteToFile( File *file ) const {
 	}
 }
 
+/*
+================
+Dict::AddEntry
+================
+*/
+void Dict::AddEntry( int hash, const char *key, const char *foldedKey, const char *value ) {
+	KeyValue kv;
+	kv.key = keyPool->Alloc( key );
+	kv.value = valuePool->Alloc( value );
+	kv.foldedKey = keyPool->Alloc( foldedKey );
+	hashIndex.Add( hash, entries.Num() );
+	entries.Append( kv );
+}
+
+/*
+================
+Dict::FreeEntry
+================
+*/
+void Dict::FreeEntry( int index ) {
+	keyPool->Free( entries[index].key );
+	valuePool->Free( entries[index].value );
+	keyPool->Free( entries[index].foldedKey );
+}
+
 }
@@ -62,9 +62,11 @@ HashIndex::HashIndex( int _hashSize ) {
 
 	hashSize = _hashSize;
 	mask = hashSize-1;
-	initialized = false;
-	nodeList = OG_NULL;
-	findNode = OG_NULL;
+	numEntries = 0;
+	slots = OG_NULL;
+	findHash = 0;
+	findPos = 0;
+	findDist = 0;
 }
 
 /*
@@ -81,13 +83,25 @@ HashIndex::~HashIndex() {
 HashIndex::Init
 ================
 */
-void HashIndex::Init( void ) {
-	OG_ASSERT( hashSize > 0 && MathIsPowerOfTwo( hashSize ) );
-	nodeList = new HashIndexNode_s *[hashSize];
-	memset(nodeList, 0, sizeof(HashIndexNode_s *) * hashSize);
-	initialized = true;
+void HashIndex::Init( int size ) {
+	OG_ASSERT( size > 0 && MathIsPowerOfTwo( size ) );
+	Slot *oldSlots = slots;
+	int oldSize = hashSize;
 
-	findNode = OG_NULL;
+	hashSize = size;
+	mask = hashSize-1;
+	numEntries = 0;
+	slots = new Slot[hashSize];
+	for( int i=0; i<hashSize; i++ )
+		slots[i].index = -1;
+
+	if ( oldSlots ) {
+		for( int i=0; i<oldSize; i++ ) {
+			if ( oldSlots[i].index != -1 )
+				Insert( oldSlots[i].hash, oldSlots[i].index );
+		}
+		delete[] oldSlots;
+	}
 }
 
 /*
@@ -96,61 +110,104 @@ HashIndex::Clear
 ================
 */
 void HashIndex::Clear( int newHashSize ) {
-	if ( initialized ) {
-		HashIndexNode_s *node;
-		HashIndexNode_s *nextNode;
-		for( int i=0; i<hashSize; i++ ) {
-			if ( nodeList[i] ) {
-				node = nodeList[i];
-				while ( node ) {
-					nextNode = node->next;
-					delete node;
-					node = nextNode;
-				}
-			}
-		}
-		delete[] nodeList;
-		nodeList = OG_NULL;
-		allnodes.Clear();
-		findNode = OG_NULL;
-
-		initialized = false;
+	if ( slots ) {
+		delete[] slots;
+		slots = OG_NULL;
+		numEntries = 0;
 	}
 	if ( newHashSize != -1 ) {
 		OG_ASSERT( newHashSize > 0 && MathIsPowerOfTwo( newHashSize ) );
 		hashSize = newHashSize;
+		mask = hashSize-1;
 	}
 }
 
 /*
 ================
-HashIndex::Add
+HashIndex::Insert
 ================
 */
-void HashIndex::Add( int hash, int index ) {
-	if ( !initialized )
-		Init();
-
-	int nodeIndex = (hash & mask);
-	HashIndexNode_s *node = nodeList[nodeIndex];
-	if ( node ) {
-		while ( node->next ) {
-			if ( node->index == index )
-				return;
-			node = node->next;
-		}
-		if ( node->index == index )
+void HashIndex::Insert( int hash, int index ) {
+	Slot entry;
+	entry.hash = hash;
+	entry.index = index;
+
+	int pos = hash & mask;
+	int dist = 0;
+	for(;;) {
+		Slot &slot = slots[pos];
+		if ( slot.index == -1 ) {
+			slot = entry;
+			numEntries++;
 			return;
+		}
 
-		node->next = new HashIndexNode_s;
-		node = node->next;
+		// Take the place of entries that are closer to their origin
+		int slotDist = ProbeDistance( pos, slot.hash );
+		if ( slotDist < dist ) {
+			Slot temp = slot;
+			slot = entry;
+			entry = temp;
+			dist = slotDist;
+		}
+		pos = (pos + 1) & mask;
+		dist++;
 	}
-	else {
-		node = nodeList[nodeIndex] = new HashIndexNode_s;
+}
+
+/*
+================
+HashIndex::FindSlot
+================
+*/
+int HashIndex::FindSlot( int hash, int index ) const {
+	if ( slots == OG_NULL )
+		return -1;
+
+	int pos = hash & mask;
+	for( int dist=0; ; dist++ ) {
+		const Slot &slot = slots[pos];
+		if ( slot.index == -1 || ProbeDistance( pos, slot.hash ) < dist )
+			return -1;
+		if ( slot.index == index && slot.hash == hash )
+			return pos;
+		pos = (pos + 1) & mask;
+	}
+}
+
+/*
+================
+HashIndex::EraseSlot
+================
+*/
+void HashIndex::EraseSlot( int pos ) {
+	for(;;) {
+		int next = (pos + 1) & mask;
+		const Slot &nextSlot = slots[next];
+		if ( nextSlot.index == -1 || ProbeDistance( next, nextSlot.hash ) == 0 )
+			break;
+		slots[pos] = nextSlot;
+		pos = next;
 	}
-	node->next = OG_NULL;
-	node->index = index;
-	allnodes.Append(node);
+	slots[pos].index = -1;
+	numEntries--;
+}
+
+/*
+================
+HashIndex::Add
+================
+*/
+void HashIndex::Add( int hash, int index ) {
+	if ( slots == OG_NULL )
+		Init( hashSize );
+	else if ( FindSlot( hash, index ) != -1 )
+		return;
+
+	// Keep at least a quarter of the slots free
+	if ( (numEntries + 1) * 4 > hashSize * 3 )
+		Init( hashSize * 2 );
+	Insert( hash, index );
 }
 
 /*
@@ -159,37 +216,41 @@ HashIndex::Remove
 ================
 */
 void HashIndex::Remove( int hash, int index ) {
-	if ( !initialized )
+	int pos = FindSlot( hash, index );
+	OG_ASSERT( pos != -1 ); // this must exist
+	if ( pos == -1 )
 		return;
+	EraseSlot( pos );
 
-	int nodeIndex = (hash & mask);
-	HashIndexNode_s *lastNode = OG_NULL;
-	HashIndexNode_s *node = nodeList[nodeIndex];
-
-	OG_ASSERT(node); // this must exist
-	while ( node ) {
-		if ( node->index == index ) {
-			if ( lastNode )
-				lastNode->next = node->next;
-			else
-				nodeList[nodeIndex] = node->next;
-
-			int i = allnodes.Find(node);
-			allnodes.Remove(i);
-
-			// decrease all nodes indices that are above the deleted nodes index
-			int num = allnodes.Num();
-			for( int i=0; i<num; i++ ) {
-				if ( allnodes[i]->index > index )
-					allnodes[i]->index--;
-			}
-
-			delete node;
-			return;
-		}
-		lastNode = node;
-		node = node->next;
+	// decrease all indices that are above the deleted index
+	for( int i=0; i<hashSize; i++ ) {
+		if ( slots[i].index > index )
+			slots[i].index--;
 	}
 }
 
+/*
+================
+HashIndex::RemoveFast
+================
+*/
+void HashIndex::RemoveFast( int hash, int index ) {
+	int pos = FindSlot( hash, index );
+	OG_ASSERT( pos != -1 ); // this must exist
+	if ( pos != -1 )
+		EraseSlot( pos );
+}
+
+/*
+================
+HashIndex::Move
+================
+*/
+void HashIndex::Move( int hash, int oldIndex, int newIndex ) {
+	int pos = FindSlot( hash, oldIndex );
+	OG_ASSERT( pos != -1 ); // this must exist
+	if ( pos != -1 )
+		slots[pos].index = newIndex;
+}
+
 }
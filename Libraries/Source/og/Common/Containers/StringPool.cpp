@@ -106,8 +106,13 @@ void StringPool::Free( const PoolString *poolStr ) {
 
 		OG_ASSERT( i != -1 );
 		OG_ASSERT( &strings[i] == poolStr );
-		strings.Remove( i );
-		hashIndex.Remove( hash, i );
+
+		// The order does not matter, so move the last string into the gap
+		hashIndex.RemoveFast( hash, i );
+		int last = strings.Num() - 1;
+		if ( i != last )
+			hashIndex.Move( hashIndex.GenerateKey( strings[last].c_str(), caseSensitive ), last, i );
+		strings.RemoveFast( i );
 	}
 }
 
@@ -28,9 +28,228 @@ freely, subject to the following restrictions:
 */
 
 #include <og/Common/Thread/JobManager.h>
+#include <og/Common/Thread/Fiber.h>
 
 namespace og {
 
+static OG_THREAD_LOCAL WorkerThread *currentWorker = OG_NULL;	// The WorkerThread running on this thread, if any
+
+/*
+================
+SpinLock
+================
+*/
+static OG_INLINE void SpinLock( volatile int *lock ) {
+	while( AtomicCompareExchange( lock, 1, 0 ) != 0 )
+		;
+}
+
+/*
+================
+SpinUnlock
+================
+*/
+static OG_INLINE void SpinUnlock( volatile int *lock ) {
+	AtomicExchange( lock, 0 );
+}
+
+/*
+==============================================================================
+
+  JobPool
+
+==============================================================================
+*/
+static const int JOB_POOL_CLASSES		= 4;	// 32, 64, 128 and 256 bytes
+static const int JOB_POOL_MAX_CACHED	= 256;	// Per thread and class, the rest goes to the shared list
+static const int JOB_POOL_BATCH			= 64;	// Number of blocks moved between a thread and the shared list
+
+struct FreeJob {
+	FreeJob *next;
+};
+
+struct JobPoolShared {
+	volatile int	lock;
+	FreeJob *		list;
+};
+static JobPoolShared jobPoolShared[JOB_POOL_CLASSES];	// Zero initialized, so it's usable before any constructor ran
+
+/*
+================
+JobPoolClass
+================
+*/
+static OG_INLINE int JobPoolClass( size_t size ) {
+	int index = 0;
+	while( size > (static_cast<size_t>(32) << index) )
+		index++;
+	return index;
+}
+
+/*
+================
+JobPoolClassSize
+================
+*/
+static OG_INLINE size_t JobPoolClassSize( int index ) {
+	return static_cast<size_t>(32) << index;
+}
+
+// The free blocks of one thread
+class JobPoolCache {
+public:
+	JobPoolCache() {
+		for( int i=0; i<JOB_POOL_CLASSES; i++ ) {
+			list[i] = OG_NULL;
+			num[i] = 0;
+		}
+	}
+	// Called when the thread ends, hand everything to the other threads
+	~JobPoolCache() {
+		for( int i=0; i<JOB_POOL_CLASSES; i++ )
+			Flush( i, num[i] );
+	}
+
+	void *Alloc( int index ) {
+		if ( list[index] == OG_NULL ) {
+			Refill( index );
+			if ( list[index] == OG_NULL )
+				return ::operator new( JobPoolClassSize( index ) );
+		}
+		FreeJob *block = list[index];
+		list[index] = block->next;
+		num[index]--;
+		return block;
+	}
+
+	void Free( void *ptr, int index ) {
+		FreeJob *block = static_cast<FreeJob *>(ptr);
+		block->next = list[index];
+		list[index] = block;
+		if ( ++num[index] > JOB_POOL_MAX_CACHED )
+			Flush( index, JOB_POOL_BATCH );
+	}
+
+private:
+	// Take a batch from the shared list
+	void Refill( int index ) {
+		JobPoolShared &shared = jobPoolShared[index];
+		SpinLock( &shared.lock );
+		int count = 0;
+		FreeJob *first = shared.list;
+		FreeJob *last = OG_NULL;
+		for( FreeJob *block = first; block && count < JOB_POOL_BATCH; block = block->next ) {
+			last = block;
+			count++;
+		}
+		if ( last ) {
+			shared.list = last->next;
+			last->next = list[index];
+			list[index] = first;
+			num[index] += count;
+		}
+		SpinUnlock( &shared.lock );
+	}
+
+	// Move count blocks to the shared list
+	void Flush( int index, int count ) {
+		if ( count <= 0 )
+			return;
+		FreeJob *first = list[index];
+		FreeJob *last = first;
+		for( int i=1; i<count; i++ )
+			last = last->next;
+		list[index] = last->next;
+		num[index] -= count;
+
+		JobPoolShared &shared = jobPoolShared[index];
+		SpinLock( &shared.lock );
+		last->next = shared.list;
+		shared.list = first;
+		SpinUnlock( &shared.lock );
+	}
+
+	FreeJob *	list[JOB_POOL_CLASSES];	// The free blocks
+	int			num[JOB_POOL_CLASSES];	// Number of free blocks
+};
+
+static TLS<JobPoolCache> jobPoolCache;
+
+/*
+================
+Job::operator new
+================
+*/
+void *Job::operator new( size_t size ) {
+	if ( size > MAX_POOLED_SIZE )
+		return ::operator new( size );
+	return jobPoolCache->Alloc( JobPoolClass( size ) );
+}
+
+/*
+================
+Job::operator delete
+
+Jobs have a virtual destructor, so size is the size of the actual class
+================
+*/
+void Job::operator delete( void *ptr, size_t size ) {
+	if ( ptr == OG_NULL )
+		return;
+	if ( size > MAX_POOLED_SIZE )
+		::operator delete( ptr );
+	else
+		jobPoolCache->Free( ptr, JobPoolClass( size ) );
+}
+
+/*
+==============================================================================
+
+  JobTraceBuffer
+
+==============================================================================
+*/
+struct JobTraceEvent {
+	const char *	name;	// The job name, NULL for idle time
+	uLongLong		queued;	// When the job got queued
+	uLongLong		start;	// When the job started
+	uLongLong		end;	// When the job finished
+	int				depth;	// The number of queued jobs when it started
+};
+
+// Ring buffer of trace events, written by one thread ( or under lock )
+class JobTraceBuffer {
+public:
+	JobTraceBuffer( int _size ) : size(_size), next(0), lock(0) { events = new JobTraceEvent[size]; }
+	~JobTraceBuffer() { delete[] events; }
+
+	JobTraceEvent *	events;	// The events
+	int				size;	// The number of events
+	volatile int	next;	// Total number of recorded events, the next one goes to next % size
+	volatile int	lock;	// Spinlock for the buffer shared by non-worker threads
+};
+
+/*
+================
+WriteTraceString
+
+Write a string to a json file
+================
+*/
+static void WriteTraceString( File *file, const char *str ) {
+	char buffer[128];
+	int len = 0;
+	buffer[len++] = '"';
+	for( ; *str && len < 124; str++ ) {
+		if ( *str == '"' || *str == '\\' )
+			buffer[len++] = '\\';
+		if ( static_cast<byte>(*str) >= 0x20 )
+			buffer[len++] = *str;
+	}
+	buffer[len++] = '"';
+	file->Write( buffer, len );
+}
+
 /*
 ==============================================================================
 
@@ -38,31 +257,91 @@ namespace og {
 
 ==============================================================================
 */
+/*
+================
+WorkerThread::WakeUp
+================
+*/
+void WorkerThread::WakeUp( void ) {
+	manager->idleCondition.Broadcast();
+}
+
 /*
 ================
 WorkerThread::Run
 ================
 */
 void WorkerThread::Run( void ) {
-	wakeUpEvent.Lock();
+	currentWorker = this;
 	while( keepRunning ) {
-		if ( !job )
-			wakeUpEvent.Wait();
-		if ( job ) {
-			switch( job->Execute() ) {
-				case JOB_DONE: break;
-				case JOB_REPEAT:
-					manager->AddJob( job );
-					break;
-				case JOB_DELETE:
-					delete job;
-					break;
-			}
-			job = OG_NULL;
-		}
+		Job *job = manager->FindJob( this, victimSeed, false );
+		if ( job )
+			manager->ExecuteJob( job );
+		else
+			Idle();
 		manager->WorkerIsDone( this );
 	}
-	wakeUpEvent.Unlock();
+
+	if ( slot != -1 ) {
+		manager->listMutex.lock();
+		manager->ReleaseQueue( this );
+		manager->listMutex.unlock();
+	}
+	currentWorker = OG_NULL;
+}
+
+/*
+================
+WorkerThread::Idle
+================
+*/
+void WorkerThread::Idle( void ) {
+	if ( !manager->isTracing ) {
+		IdleWait();
+		return;
+	}
+	uLongLong start = SysInfo::GetHiResTime();
+	IdleWait();
+	manager->TraceEvent( OG_NULL, 0, start, SysInfo::GetHiResTime(), 0 );
+}
+
+/*
+================
+WorkerThread::IdleWait
+================
+*/
+void WorkerThread::IdleWait( void ) {
+	JobIdlePolicy policy = manager->idlePolicy;
+	if ( numSpins < 0 || !policy.adaptive )
+		numSpins = policy.maxSpins;
+
+	for( int i=0; i<numSpins; i++ ) {
+		AtomicPause();
+		if ( !keepRunning || manager->HasQueuedJobs( false ) ) {
+			// Jobs come in fast, spin longer next time
+			if ( policy.adaptive )
+				numSpins = Min( numSpins * 2, policy.maxSpins );
+			return;
+		}
+	}
+	for( int i=0; i<policy.numYields; i++ ) {
+		ogst::this_thread::yield();
+		if ( !keepRunning || manager->HasQueuedJobs( false ) )
+			return;
+	}
+
+	// Spinning didn't pay off, spin shorter next time
+	if ( policy.adaptive )
+		numSpins = Max( numSpins / 2, 1 );
+
+	// Announce that we are about to sleep before checking for jobs one last time,
+	// JobsQueued does it the other way around, so one of us will notice the other.
+	manager->idleCondition.Lock();
+	AtomicIncrement( &manager->numSleeping );
+	while( keepRunning && !manager->HasQueuedJobs( false ) )
+		manager->idleCondition.Wait();
+	AtomicDecrement( &manager->numSleeping );
+	manager->idleCondition.Unlock();
 }
 
 
@@ -79,9 +358,45 @@ void WorkerThread::Run( void ) {
 JobManager::JobManager
 ================
 */
+JobManager::JobManager() {
+	numThreadsWanted = 0;
+	isTracing = false;
+	traceWriters = 0;
+	traceSize = 0;
+	traceStart = 0;
+	for( int i=0; i<=MAX_WORKERS; i++ )
+		traceBuffers[i] = OG_NULL;
+	workerAffinity = JOB_AFFINITY_NONE;
+	waitForDone = false;
+	numQueued = 0;
+	numBackground = 0;
+	hasDeadline = false;
+	frameDeadline = 0;
+	numActive = 0;
+	numSleeping = 0;
+	numWaiting = 0;
+	numQueues = 0;
+	for( int i=0; i<MAX_WORKERS; i++ ) {
+		for( int j=0; j<JOB_PRIORITY_NUM; j++ )
+			localQueues[i][j] = OG_NULL;
+		queueInUse[i] = false;
+	}
+}
+
+/*
+================
+JobManager::~JobManager
+================
+*/
 JobManager::~JobManager() {
 	SetNumWorkers(0, true);
 	KillAll();
+	for( int i=0; i<numQueues; i++ ) {
+		for( int j=0; j<JOB_PRIORITY_NUM; j++ )
+			delete localQueues[i][j];
+	}
+	for( int i=0; i<=MAX_WORKERS; i++ )
+		delete traceBuffers[i];
 }
 
 /*
@@ -89,14 +404,127 @@ JobManager::~JobManager() {
 JobManager::AddJob
 ================
 */
-void JobManager::AddJob( Job *job ) {
-	if ( waitForDone ) {
+void JobManager::AddJob( Job *job, JobCounter *counter, JobCounter *dependency, JobPriority priority ) {
+	WorkerThread *worker = GetLocalWorker();
+
+	// Jobs spawned by running jobs are still part of the work WaitForDone waits for
+	if ( waitForDone && !worker ) {
 		if ( job->Cancel() == JOB_DELETE )
 			delete job;
-	} else {
-		jobList.Produce( job );
-		TriggerNextJob();
+		return;
+	}
+
+	job->jobCounter = counter;
+	job->priority = priority;
+	if ( counter )
+		AtomicIncrement( &counter->count );
+
+	AtomicIncrement( &numActive );
+	if ( dependency == OG_NULL || !AddWaitingJob( job, dependency ) )
+		PushJob( job, worker );
+}
+
+/*
+================
+JobManager::AddJobs
+================
+*/
+void JobManager::AddJobs( Job **jobs, int num, JobCounter *counter, JobCounter *dependency, JobPriority priority ) {
+	if ( num <= 0 )
+		return;
+
+	WorkerThread *worker = GetLocalWorker();
+	if ( waitForDone && !worker ) {
+		for( int i=0; i<num; i++ ) {
+			if ( jobs[i]->Cancel() == JOB_DELETE )
+				delete jobs[i];
+		}
+		return;
+	}
+
+	if ( counter )
+		AtomicAdd( &counter->count, num );
+	AtomicAdd( &numActive, num );
+
+	int numPushed = 0;
+	for( int i=0; i<num; i++ ) {
+		Job *job = jobs[i];
+		job->jobCounter = counter;
+		job->priority = priority;
+		if ( dependency == OG_NULL || !AddWaitingJob( job, dependency ) ) {
+			QueueJob( job, worker );
+			numPushed++;
+		}
 	}
+	if ( numPushed == 0 )
+		return;
+	if ( priority == JOB_PRIORITY_BACKGROUND )
+		JobsQueued( 0, numPushed );
+	else
+		JobsQueued( numPushed, 0 );
+}
+
+/*
+================
+JobManager::Wait
+================
+*/
+void JobManager::Wait( JobCounter &counter ) {
+	WorkerThread *worker = GetLocalWorker();
+	uInt seed = worker ? worker->victimSeed : static_cast<uInt>( reinterpret_cast<size_t>(&counter) ) | 1;
+
+	while( !counter.IsDone() ) {
+		Job *job = FindJob( worker, seed, true );
+		if ( job ) {
+			ExecuteJob( job );
+			continue;
+		}
+
+		// Nothing to help out with, sleep until the counter is done or new jobs arrive
+		idleCondition.Lock();
+		AtomicIncrement( &numWaiting );
+		AtomicIncrement( &numSleeping );
+		while( !counter.IsDone() && !HasQueuedJobs( true ) )
+			idleCondition.Wait();
+		AtomicDecrement( &numSleeping );
+		AtomicDecrement( &numWaiting );
+		idleCondition.Unlock();
+	}
+	if ( worker )
+		worker->victimSeed = seed;
+}
+
+/*
+================
+JobManager::SetFrameDeadline
+================
+*/
+void JobManager::SetFrameDeadline( int microseconds ) {
+	if ( microseconds <= 0 )
+		hasDeadline = false;
+	else {
+		AtomicExchange( &frameDeadline, static_cast<int>( SysInfo::GetHiResTime() + microseconds ) );
+		hasDeadline = true;
+	}
+
+	// Background jobs might have been held back
+	if ( numBackground > 0 && numSleeping > 0 )
+		idleCondition.Broadcast();
+}
+
+/*
+================
+JobManager::IsFrameLate
+================
+*/
+bool JobManager::IsFrameLate( void ) const {
+	// Nothing gets held back while waiting to be done
+	if ( !hasDeadline || waitForDone )
+		return false;
+
+	// Safe for wrap arounds, as long as the deadline is less than half an hour away
+	uInt now = static_cast<uInt>( SysInfo::GetHiResTime() );
+	return static_cast<int>( now - static_cast<uInt>(frameDeadline) ) > 0;
 }
 
 /*
@@ -105,15 +533,24 @@ JobManager::SetNumWorkers
 ================
 */
 void JobManager::SetNumWorkers( int num, bool blocking ) {
+	if ( num == AUTO_WORKERS ) {
+		const CPU::Topology &topology = SysInfo::topology;
+		bool perCore = workerAffinity == JOB_AFFINITY_CORE || workerAffinity == JOB_AFFINITY_NODE;
+		num = Max( (perCore ? topology.numUsableCores : topology.numUsable) - 1, 1 );
+	}
+	num = Clamp( num, 0, MAX_WORKERS );
 	listMutex.lock();
 	if ( num != numThreadsWanted ) {
 		if ( num > allThreads.Num() ) {
 			numThreadsWanted = num;
 			while( num > allThreads.Num() ) {
-				WorkerThread *worker = new WorkerThread(this);
-				worker->Start("Job Manager");
+				int slot = AllocQueue();
+				if ( slot == -1 )
+					break;
+				WorkerThread *worker = new WorkerThread(this, slot);
+				worker->SetAffinity( GetWorkerAffinity( slot ) );
 				allThreads.Append( worker );
-				AddFreeWorker( worker );
+				worker->Start("Job Manager");
 			}
 		} else if ( blocking ) {
 			numThreadsWanted = -1;
@@ -138,21 +575,23 @@ JobManager::WaitForDone
 */
 void JobManager::WaitForDone( void ) {
 	listMutex.lock();
-	if ( allThreads.IsEmpty() )
-		return;
+	bool noWorkers = allThreads.IsEmpty();
 	listMutex.unlock();
+	if ( noWorkers )
+		return;
 
 	// do not allow adding new jobs while waiting for done
 	waitForDone = true;
-	doneWaiter.Lock();
-
-	// create a job and wait for it to be done
-	jobList.Produce( new JobStopWaitDone(this) );
-	TriggerNextJob();
+	AtomicFence();
+	if ( numBackground > 0 && numSleeping > 0 )
+		idleCondition.Broadcast();
 
-	while( waitForDone )
+	doneWaiter.Lock();
+	while( numActive > 0 )
 		doneWaiter.Wait();
 	doneWaiter.Unlock();
+
+	waitForDone = false;
 }
 
 /*
@@ -162,29 +601,288 @@ JobManager::KillAll
 */
 void JobManager::KillAll( void ) {
 	Job *job;
-	while( (job=jobList.Consume()) != OG_NULL ) {
-		if ( job->Cancel() == JOB_DELETE )
+	for( int p=0; p<JOB_PRIORITY_NUM; p++ ) {
+		while( (job=jobList[p].Consume()) != OG_NULL )
+			CancelJob( job );
+
+		for( int i=0; i<numQueues; i++ ) {
+			while( localQueues[i][p]->Num() > 0 ) {
+				if ( (job=localQueues[i][p]->Steal()) != OG_NULL )
+					CancelJob( job );
+			}
+		}
+	}
+}
+
+/*
+================
+JobManager::GetLocalWorker
+================
+*/
+WorkerThread *JobManager::GetLocalWorker( void ) const {
+	WorkerThread *worker = currentWorker;
+	if ( worker && worker->manager == this && worker->slot != -1 )
+		return worker;
+	return OG_NULL;
+}
+
+/*
+================
+JobManager::PushJob
+================
+*/
+void JobManager::PushJob( Job *job, WorkerThread *worker ) {
+	QueueJob( job, worker );
+	if ( job->priority == JOB_PRIORITY_BACKGROUND )
+		JobsQueued( 0, 1 );
+	else
+		JobsQueued( 1, 0 );
+}
+
+/*
+================
+JobManager::QueueJob
+================
+*/
+void JobManager::QueueJob( Job *job, WorkerThread *worker ) {
+	if ( isTracing )
+		job->queuedTime = SysInfo::GetHiResTime();
+
+	int priority = job->priority;
+	if ( !worker || !localQueues[worker->slot][priority]->Push( job ) )
+		jobList[priority].Produce( job );
+}
+
+/*
+================
+JobManager::JobsQueued
+================
+*/
+void JobManager::JobsQueued( int num, int numBg ) {
+	if ( num > 0 )
+		AtomicAdd( &numQueued, num );
+	if ( numBg > 0 ) {
+		AtomicAdd( &numBackground, numBg );
+		// Workers might hold them back, so make sure Wait() sees them
+		if ( numWaiting > 0 ) {
+			idleCondition.Broadcast();
+			return;
+		}
+	}
+
+	// Wake up as many workers as there are new jobs
+	int sleeping = numSleeping;
+	if ( sleeping <= 0 )
+		return;
+	int wake = num + numBg;
+	if ( wake >= sleeping )
+		idleCondition.Broadcast();
+	else {
+		while( wake-- > 0 )
+			idleCondition.Signal();
+	}
+}
+
+/*
+================
+JobManager::FindJob
+================
+*/
+Job *JobManager::FindJob( WorkerThread *worker, uInt &seed, bool allowBackground ) {
+	for( int p=0; p<JOB_PRIORITY_NUM; p++ ) {
+		volatile int *num = &numQueued;
+		if ( p == JOB_PRIORITY_BACKGROUND ) {
+			if ( numBackground <= 0 || (!allowBackground && IsFrameLate()) )
+				break;
+			num = &numBackground;
+		}
+		else if ( numQueued <= 0 )
+			continue;
+
+		Job *job = worker ? localQueues[worker->slot][p]->Pop() : OG_NULL;
+		if ( job == OG_NULL ) {
+			job = jobList[p].Consume();
+			if ( job == OG_NULL ) {
+				job = StealJob( worker ? worker->slot : -1, seed, p );
+				if ( job == OG_NULL )
+					continue;
+			}
+		}
+
+		// There is more to do, get another worker going
+		AtomicDecrement( num );
+		if ( numSleeping > 0 && HasQueuedJobs( false ) )
+			idleCondition.Signal();
+		return job;
+	}
+	return OG_NULL;
+}
+
+/*
+================
+JobManager::StealJob
+================
+*/
+Job *JobManager::StealJob( int skipSlot, uInt &seed, int priority ) {
+	int num = numQueues;
+	if ( num == 0 || (num == 1 && skipSlot == 0) )
+		return OG_NULL;
+
+	// xorshift to pick a random victim to start with
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	int start = static_cast<int>( seed % static_cast<uInt>(num) );
+	for( int i=0; i<num; i++ ) {
+		int victim = (start + i) % num;
+		if ( victim == skipSlot )
+			continue;
+		Job *job = localQueues[victim][priority]->Steal();
+		if ( job )
+			return job;
+	}
+	return OG_NULL;
+}
+
+/*
+================
+JobManager::HasQueuedJobs
+================
+*/
+bool JobManager::HasQueuedJobs( bool allowBackground ) const {
+	if ( numQueued > 0 )
+		return true;
+	return numBackground > 0 && (allowBackground || !IsFrameLate());
+}
+
+/*
+================
+JobManager::ExecuteJob
+================
+*/
+void JobManager::ExecuteJob( Job *job ) {
+	// The job might be gone after Execute
+	JobCounter *counter = job->jobCounter;
+
+	JobResult result;
+	if ( !isTracing )
+		result = job->Execute();
+	else {
+		const char *name = job->GetName();
+		uLongLong queued = job->queuedTime;
+		int depth = numQueued + numBackground;
+		uLongLong start = SysInfo::GetHiResTime();
+		result = job->Execute();
+		TraceEvent( name, queued, start, SysInfo::GetHiResTime(), depth );
+	}
+
+	switch( result ) {
+		case JOB_DONE: break;
+		case JOB_REPEAT:
+			// Repeated jobs go to the end of the global queue, so they don't starve the local ones
+			if ( !waitForDone ) {
+				PushJob( job, OG_NULL );
+				return;
+			}
+			if ( job->Cancel() == JOB_DELETE )
+				delete job;
+			break;
+		case JOB_DELETE:
 			delete job;
+			break;
+		case JOB_SUSPEND: {
+			// Still active, it gets queued again once the counter is done
+			JobCounter *resume = job->resumeCounter;
+			job->resumeCounter = OG_NULL;
+			if ( resume == OG_NULL || !AddWaitingJob( job, resume ) )
+				PushJob( job, GetLocalWorker() );
+			return;
+		}
 	}
+	if ( counter )
+		DecrementCounter( counter );
+	JobFinished();
 }
 
 /*
 ================
-JobManager::TriggerNextJob
+JobManager::CancelJob
 ================
 */
-void JobManager::TriggerNextJob( bool wakeUp ) {
-	WorkerThread *worker = availableThreads.Consume();
-	if ( worker ) {
-		Job *job = jobList.Consume();
-		if( job == OG_NULL )
-			availableThreads.Produce( worker );
-		else {
-			worker->SetJob( job );
-			if ( wakeUp )
-				worker->WakeUp();
+void JobManager::CancelJob( Job *job ) {
+	AtomicDecrement( job->priority == JOB_PRIORITY_BACKGROUND ? &numBackground : &numQueued );
+
+	JobCounter *counter = job->jobCounter;
+	if ( job->Cancel() == JOB_DELETE )
+		delete job;
+	if ( counter )
+		DecrementCounter( counter );
+	JobFinished();
+}
+
+/*
+================
+JobManager::AddWaitingJob
+================
+*/
+bool JobManager::AddWaitingJob( Job *job, JobCounter *dependency ) {
+	SpinLock( &dependency->lock );
+	if ( dependency->count == 0 ) {
+		SpinUnlock( &dependency->lock );
+		return false;
+	}
+	job->nextWaiting = dependency->waiting;
+	dependency->waiting = job;
+	SpinUnlock( &dependency->lock );
+	return true;
+}
+
+/*
+================
+JobManager::DecrementCounter
+================
+*/
+void JobManager::DecrementCounter( JobCounter *counter ) {
+	// Decrement while locked, so IsDone() stays false until we're done touching the counter.
+	// The owner might destroy it right after that.
+	SpinLock( &counter->lock );
+	Job *job = OG_NULL;
+	if ( AtomicDecrement( &counter->count ) == 0 ) {
+		job = counter->waiting;
+		counter->waiting = OG_NULL;
+	}
+	SpinUnlock( &counter->lock );
+
+	if ( job ) {
+		WorkerThread *worker = GetLocalWorker();
+		int num = 0, numBg = 0;
+		while( job ) {
+			Job *next = job->nextWaiting;
+			job->nextWaiting = OG_NULL;
+			QueueJob( job, worker );
+			if ( job->priority == JOB_PRIORITY_BACKGROUND )
+				numBg++;
+			else
+				num++;
+			job = next;
 		}
+		JobsQueued( num, numBg );
 	}
+
+	// Wake up everyone in Wait(), the counter might be theirs
+	if ( numWaiting > 0 )
+		idleCondition.Broadcast();
+}
+
+/*
+================
+JobManager::JobFinished
+================
+*/
+void JobManager::JobFinished( void ) {
+	if ( AtomicDecrement( &numActive ) == 0 && waitForDone )
+		doneWaiter.Signal();
 }
 
 /*
@@ -193,26 +891,307 @@ JobManager::WorkerIsDone
 ================
 */
 void JobManager::WorkerIsDone( WorkerThread *worker ) {
+	// Only lock if it looks like there are too many workers
+	if ( numThreadsWanted == -1 || numThreadsWanted >= allThreads.Num() )
+		return;
+
 	listMutex.lock();
-	if ( numThreadsWanted >= allThreads.Num() )
-		AddFreeWorker( worker, false );
-	else if ( numThreadsWanted != -1 ) {
-		worker->Stop( false );
+	if ( numThreadsWanted != -1 && numThreadsWanted < allThreads.Num() ) {
 		int index = allThreads.Find( worker );
-		if ( index )
+		if ( index != -1 )
 			allThreads.Remove( index );
+		ReleaseQueue( worker );
+		worker->Stop( false );
 	}
 	listMutex.unlock();
 }
 
 /*
 ================
-JobManager::AddFreeWorker
+JobManager::AllocQueue
 ================
 */
-void JobManager::AddFreeWorker( WorkerThread *worker, bool wakeUp ) {
-	availableThreads.Produce( worker );
-	TriggerNextJob( wakeUp );
+int JobManager::AllocQueue( void ) {
+	for( int i=0; i<numQueues; i++ ) {
+		if ( !queueInUse[i] ) {
+			queueInUse[i] = true;
+			return i;
+		}
+	}
+	if ( numQueues == MAX_WORKERS )
+		return -1;
+
+	int slot = numQueues;
+	for( int i=0; i<JOB_PRIORITY_NUM; i++ )
+		localQueues[slot][i] = new WorkStealingQueue<Job>;
+	queueInUse[slot] = true;
+	AtomicIncrement( &numQueues );
+	return slot;
+}
+
+/*
+================
+JobManager::ReleaseQueue
+================
+*/
+void JobManager::ReleaseQueue( WorkerThread *worker ) {
+	Job *job;
+	for( int i=0; i<JOB_PRIORITY_NUM; i++ ) {
+		while( (job=localQueues[worker->slot][i]->Pop()) != OG_NULL )
+			jobList[i].Produce( job );
+	}
+	queueInUse[worker->slot] = false;
+	worker->slot = -1;
+}
+
+/*
+==============================================================================
+
+  FiberJob
+
+==============================================================================
+*/
+
+/*
+================
+FiberJob::Execute
+================
+*/
+JobResult FiberJob::Execute( void ) {
+	if ( fiber == OG_NULL ) {
+		fiber = new Fiber( FiberMain, this, fiberStackSize );
+		if ( !fiber->IsValid() ) {
+			User::Error( ERR_SYSTEM_REQUIREMENTS, "Can't create fiber" );
+			delete fiber;
+			fiber = OG_NULL;
+			return JOB_DONE;
+		}
+		isFinished = false;
+	}
+
+	fiber->Enter();
+	if ( !isFinished )
+		return JOB_SUSPEND;
+
+	// Start over on a fresh fiber if it gets executed again
+	delete fiber;
+	fiber = OG_NULL;
+	OG_ASSERT( result != JOB_SUSPEND );
+	return result;
+}
+
+/*
+================
+FiberJob::WaitFor
+================
+*/
+void FiberJob::WaitFor( JobCounter &counter ) {
+	if ( counter.IsDone() )
+		return;
+	SuspendUntil( &counter );
+	fiber->Leave();
+}
+
+/*
+================
+FiberJob::FiberMain
+================
+*/
+void FiberJob::FiberMain( void *param ) {
+	FiberJob *job = static_cast<FiberJob *>(param);
+	job->result = job->Run();
+	job->isFinished = true;
+	job->fiber->Leave();
+}
+
+/*
+================
+JobManager::GetWorkerAffinity
+================
+*/
+uLongLong JobManager::GetWorkerAffinity( int slot ) const {
+	if ( workerAffinity == JOB_AFFINITY_NONE )
+		return 0;
+
+	// Order the usable logical processors by the index within their core, then by node,
+	// so the first hyperthread of every core comes before any second one.
+	// Processors outside of the process affinity mask get skipped ( rank -1 ).
+	const CPU::Topology &topology = SysInfo::topology;
+	int order[CPU::Topology::MAX_LOGICAL];
+	int rank[CPU::Topology::MAX_LOGICAL];
+	int num = 0;
+	for( int i=0; i<topology.numLogical; i++ ) {
+		if ( !( topology.usable & (static_cast<uLongLong>(1) << i) ) ) {
+			rank[i] = -1;
+			continue;
+		}
+		rank[i] = 0;
+		for( int j=0; j<i; j++ ) {
+			if ( rank[j] != -1 && topology.core[j] == topology.core[i] )
+				rank[i]++;
+		}
+	}
+	for( int r=0; r<topology.numLogical; r++ ) {
+		for( int n=0; n<topology.numNodes; n++ ) {
+			for( int i=0; i<topology.numLogical; i++ ) {
+				if ( topology.node[i] == n && rank[i] == r )
+					order[num++] = i;
+			}
+		}
+	}
+	if ( num == 0 )
+		return 0;
+
+	if ( workerAffinity == JOB_AFFINITY_LOGICAL )
+		return static_cast<uLongLong>(1) << order[slot % num];
+
+	// The first hyperthreads represent the cores
+	int numCores = 0;
+	int cores[CPU::Topology::MAX_LOGICAL];
+	for( int i=0; i<num; i++ ) {
+		if ( rank[order[i]] == 0 )
+			cores[numCores++] = order[i];
+	}
+	int first = cores[slot % numCores];
+
+	uLongLong mask = 0;
+	for( int i=0; i<topology.numLogical; i++ ) {
+		bool match = (workerAffinity == JOB_AFFINITY_CORE) ? topology.core[i] == topology.core[first]
+															: topology.node[i] == topology.node[first];
+		if ( match )
+			mask |= static_cast<uLongLong>(1) << i;
+	}
+	return mask & topology.usable;
+}
+
+/*
+================
+JobManager::StartTrace
+================
+*/
+void JobManager::StartTrace( int eventsPerThread ) {
+	StopTrace();
+
+	// Nobody is recording now, so the buffers can be replaced safely.
+	// Workers which get a new slot while tracing record to the shared buffer.
+	traceSize = Max( eventsPerThread, 1 );
+	for( int i=0; i<=MAX_WORKERS; i++ ) {
+		if ( traceBuffers[i] && traceBuffers[i]->size != traceSize )
+			SafeDelete( traceBuffers[i] );
+		if ( traceBuffers[i] == OG_NULL && (i == MAX_WORKERS || i < numQueues) )
+			traceBuffers[i] = new JobTraceBuffer( traceSize );
+		if ( traceBuffers[i] )
+			traceBuffers[i]->next = 0;
+	}
+	traceStart = SysInfo::GetHiResTime();
+	AtomicFence();
+	isTracing = true;
+}
+
+/*
+================
+JobManager::StopTrace
+================
+*/
+void JobManager::StopTrace( void ) {
+	isTracing = false;
+	AtomicFence();
+
+	// Wait for the events which are being recorded right now
+	while( traceWriters > 0 )
+		ogst::this_thread::yield();
+}
+
+/*
+================
+JobManager::TraceEvent
+================
+*/
+void JobManager::TraceEvent( const char *name, uLongLong queued, uLongLong start, uLongLong end, int depth ) {
+	// Announce the write before checking isTracing, StopTrace does it the other way around,
+	// so the buffers don't get touched once StopTrace returned.
+	AtomicIncrement( &traceWriters );
+	if ( isTracing ) {
+		// Only the owner of the slot writes to a worker buffer
+		WorkerThread *worker = GetLocalWorker();
+		JobTraceBuffer *buffer = worker ? traceBuffers[worker->slot] : OG_NULL;
+		bool shared = ( buffer == OG_NULL );
+		if ( shared ) {
+			buffer = traceBuffers[MAX_WORKERS];
+			SpinLock( &buffer->lock );
+		}
+
+		JobTraceEvent &event = buffer->events[buffer->next % buffer->size];
+		event.name = name;
+		event.queued = queued;
+		event.start = start;
+		event.end = end;
+		event.depth = depth;
+		buffer->next++;
+
+		if ( shared )
+			SpinUnlock( &buffer->lock );
+	}
+	AtomicDecrement( &traceWriters );
+}
+
+/*
+================
+JobManager::WriteTrace
+================
+*/
+bool JobManager::WriteTrace( File *file ) const {
+	OG_ASSERT( !isTracing );
+	while( traceWriters > 0 )
+		ogst::this_thread::yield();
+
+	char line[256];
+	bool first = true;
+	file->Write( "{\"traceEvents\":[\n", 17 );
+	for( int i=0; i<=MAX_WORKERS; i++ ) {
+		const JobTraceBuffer *buffer = traceBuffers[i];
+		if ( buffer == OG_NULL || buffer->next == 0 )
+			continue;
+
+		int len = sprintf( line, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", i );
+		file->Write( line, len );
+		if ( i == MAX_WORKERS )
+			WriteTraceString( file, "Other threads" );
+		else {
+			len = sprintf( line, "Job Worker %d", i );
+			WriteTraceString( file, line );
+		}
+		file->Write( "}}", 2 );
+		first = false;
+
+		int num = Min( buffer->next, buffer->size );
+		for( int j=buffer->next - num; j<buffer->next; j++ ) {
+			const JobTraceEvent &event = buffer->events[j % buffer->size];
+			if ( event.start < traceStart )
+				continue;
+			uLongLong start = event.start - traceStart;
+			uLongLong duration = event.end - event.start;
+
+			file->Write( ",\n{\"name\":", 10 );
+			WriteTraceString( file, event.name ? event.name : "Idle" );
+			if ( event.name == OG_NULL ) {
+				len = sprintf( line, ",\"cat\":\"idle\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%llu}", i, start, duration );
+				file->Write( line, len );
+				continue;
+			}
+
+			uLongLong wait = (event.queued > traceStart && event.queued <= event.start) ? event.start - event.queued : 0;
+			len = sprintf( line, ",\"cat\":\"job\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%llu,\"args\":{\"queueWait\":%llu,\"queued\":%d}}",
+							i, start, duration, wait, event.depth );
+			file->Write( line, len );
+
+			// Queue depth as a counter track
+			len = sprintf( line, ",\n{\"name\":\"Queued Jobs\",\"ph\":\"C\",\"pid\":1,\"ts\":%llu,\"args\":{\"jobs\":%d}}", start, event.depth );
+			file->Write( line, len );
+		}
+	}
+	file->Write( "\n]}\n", 4 );
+	return !first;
 }
 
 }
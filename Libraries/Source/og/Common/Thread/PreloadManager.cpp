@@ -44,22 +44,15 @@ public:
 		:manager(mgr), task(tsk) {
 	}
 	JobResult	Execute( void ) {
-		manager->condition.Lock();
-		if ( manager->preloaded.Num() >= manager->maxPreload )
-			manager->condition.Wait();
-		manager->condition.Unlock();
-
 		task->isLoaded = task->Preload();
-
-		manager->condition.Lock();
-		manager->preloaded.Push( task );
-		manager->condition.Unlock();
-		return JOB_DELETE;
-	}
-	JobResult	Cancel( void ) {
-		OG_ASSERT( false );
+		if ( task->isLoaded )
+			task->residentSize = task->GetResidentSize();
+		manager->TaskDone( task );
 		return JOB_DELETE;
 	}
+	// The task gets deleted by PreloadManager::Stop
+	JobResult	Cancel( void ) { return JOB_DELETE; }
+	const char *GetName( void ) const { return "Preload"; }
 
 private:
 	PreloadManager *	manager;
@@ -80,8 +73,15 @@ PreloadManager::PreloadManager
 ================
 */
 PreloadManager::PreloadManager() {
+	isRunning = false;
 	progress = 0.0f;
-	maxPreload = 1;
+	budget = DEFAULT_BUDGET;
+	residentBytes = 0;
+	runningBytes = 0;
+	numRunning = 0;
+	numFinished = 0;
+	maxRunning = 2;
+	nextSequence = 0;
 	numProcessed = 0;
 	numTotal = 0;
 }
@@ -91,9 +91,12 @@ PreloadManager::PreloadManager() {
 PreloadManager::Start
 ================
 */
-void PreloadManager::Start( int max ) {
-	manager.SetNumWorkers(1);
-	maxPreload = Max( max, 1 );
+void PreloadManager::Start( void ) {
+	mutex.lock();
+	isRunning = true;
+	mutex.unlock();
+
+	SetNumWorkers( JobManager::AUTO_WORKERS );
 }
 
 /*
@@ -102,8 +105,24 @@ PreloadManager::Stop
 ================
 */
 void PreloadManager::Stop( void ) {
+	mutex.lock();
+	isRunning = false;
+	mutex.unlock();
+
 	manager.KillAll();
 	manager.SetNumWorkers(0, true);
+
+	for( int i=0; i<waiting.Num(); i++ )
+		delete waiting[i];
+	waiting.Clear();
+	while( !started.IsEmpty() ) {
+		delete started.Front();
+		started.Pop();
+	}
+	numRunning = 0;
+	numFinished = 0;
+	residentBytes = 0;
+	runningBytes = 0;
 	ResetProgress();
 }
 
@@ -114,6 +133,22 @@ PreloadManager::SetNumWorkers
 */
 void PreloadManager::SetNumWorkers( int num ) {
 	manager.SetNumWorkers( num );
+
+	// Keep some tasks queued, so no worker runs dry while another task finishes
+	ogst::lock_guard<ogst::mutex> lock(mutex);
+	maxRunning = 2 * Max( manager.GetNumWorkers(), 1 );
+	Dispatch();
+}
+
+/*
+================
+PreloadManager::SetBudget
+================
+*/
+void PreloadManager::SetBudget( uLongLong _budget ) {
+	ogst::lock_guard<ogst::mutex> lock(mutex);
+	budget = _budget;
+	Dispatch();
 }
 
 /*
@@ -122,8 +157,178 @@ PreloadManager::AddTask
 ================
 */
 void PreloadManager::AddTask( PreloadTask *task ) {
+	task->estimatedSize = task->GetEstimatedSize();
+	task->priority = task->GetPriority();
+
+	ogst::lock_guard<ogst::mutex> lock(mutex);
+	task->sequence = nextSequence++;
 	numTotal++;
-	manager.AddJob( new PreloadJob(this, task) );
+	PushWaiting( task );
+	Dispatch();
+}
+
+/*
+================
+PreloadManager::CancelTask
+================
+*/
+bool PreloadManager::CancelTask( PreloadTask *task ) {
+	mutex.lock();
+	int index = waiting.Find( task );
+	if ( index == -1 ) {
+		mutex.unlock();
+		return false;
+	}
+	RemoveWaiting( index );
+	mutex.unlock();
+
+	delete task;
+	numProcessed++;
+	return true;
+}
+
+/*
+================
+PreloadManager::UpdatePriorities
+================
+*/
+void PreloadManager::UpdatePriorities( void ) {
+	List<PreloadTask *> cancelled;
+
+	mutex.lock();
+	int num = waiting.Num();
+	int numKept = 0;
+	for( int i=0; i<num; i++ ) {
+		PreloadTask *task = waiting[i];
+		if ( task->IsRelevant() ) {
+			task->priority = task->GetPriority();
+			waiting[numKept++] = task;
+		} else {
+			cancelled.Append( task );
+		}
+	}
+	while( waiting.Num() > numKept )
+		waiting.Remove( waiting.Num() - 1 );
+	for( int i=numKept/2-1; i>=0; i-- )
+		SiftDown( i );
+	mutex.unlock();
+
+	num = cancelled.Num();
+	for( int i=0; i<num; i++ )
+		delete cancelled[i];
+	numProcessed += num;
+}
+
+/*
+================
+PreloadManager::TaskDone
+================
+*/
+void PreloadManager::TaskDone( PreloadTask *task ) {
+	ogst::lock_guard<ogst::mutex> lock(mutex);
+	task->isDone = true;
+	numFinished++;
+	residentBytes += task->residentSize;
+	runningBytes -= task->estimatedSize;
+	numRunning--;
+	Dispatch();
+}
+
+/*
+================
+PreloadManager::Dispatch
+================
+*/
+void PreloadManager::Dispatch( void ) {
+	while( isRunning && numRunning < maxRunning && !waiting.IsEmpty() ) {
+		PreloadTask *task = waiting[0];
+
+		// If nothing is held, start it anyway, so huge tasks don't get stuck
+		uLongLong held = residentBytes + runningBytes;
+		if ( held > 0 && ( held >= budget || held + task->estimatedSize > budget ) )
+			break;
+
+		RemoveWaiting( 0 );
+		started.Push( task );
+		numRunning++;
+		runningBytes += task->estimatedSize;
+		manager.AddJob( new PreloadJob(this, task) );
+	}
+}
+
+/*
+================
+PreloadManager::IsBefore
+================
+*/
+bool PreloadManager::IsBefore( const PreloadTask *a, const PreloadTask *b ) {
+	if ( a->priority != b->priority )
+		return a->priority < b->priority;
+	return a->sequence < b->sequence;
+}
+
+/*
+================
+PreloadManager::PushWaiting
+================
+*/
+void PreloadManager::PushWaiting( PreloadTask *task ) {
+	waiting.Append( task );
+	SiftUp( waiting.Num() - 1 );
+}
+
+/*
+================
+PreloadManager::RemoveWaiting
+================
+*/
+void PreloadManager::RemoveWaiting( int index ) {
+	int last = waiting.Num() - 1;
+	waiting[index] = waiting[last];
+	waiting.Remove( last );
+	if ( index < last ) {
+		SiftUp( index );
+		SiftDown( index );
+	}
+}
+
+/*
+================
+PreloadManager::SiftUp
+================
+*/
+void PreloadManager::SiftUp( int index ) {
+	PreloadTask *task = waiting[index];
+	while( index > 0 ) {
+		int parent = (index - 1) / 2;
+		if ( !IsBefore( task, waiting[parent] ) )
+			break;
+		waiting[index] = waiting[parent];
+		index = parent;
+	}
+	waiting[index] = task;
+}
+
+/*
+================
+PreloadManager::SiftDown
+================
+*/
+void PreloadManager::SiftDown( int index ) {
+	int num = waiting.Num();
+	PreloadTask *task = waiting[index];
+	for(;;) {
+		int child = 2 * index + 1;
+		if ( child >= num )
+			break;
+		if ( child + 1 < num && IsBefore( waiting[child + 1], waiting[child] ) )
+			child++;
+		if ( !IsBefore( waiting[child], task ) )
+			break;
+		waiting[index] = waiting[child];
+		index = child;
+	}
+	waiting[index] = task;
 }
 
 /*
@@ -131,25 +336,61 @@ void PreloadManager::AddTask( PreloadTask *task ) {
 PreloadManager::Synchronize
 ================
 */
-float PreloadManager::Synchronize( void ) {
-	condition.Lock();
-	PreloadTask *task;
-	int num = preloaded.Num();
-	while( !preloaded.IsEmpty() ) {
-		task = preloaded.Front();
+float PreloadManager::Synchronize( int budgetMicroseconds ) {
+	uLongLong startTime = SysInfo::GetHiResTime();
+	uLongLong endTime = startTime;
+	uLongLong freedBytes = 0;
+	int num = 0;
+	int numDeferred = 0;
+	for(;;) {
+		// Take the finished tasks from the front, so the order stays intact
+		mutex.lock();
+		if ( started.IsEmpty() || !started.Front()->isDone ) {
+			mutex.unlock();
+			break;
+		}
+		if ( num > 0 && budgetMicroseconds > 0 && endTime - startTime >= static_cast<uLongLong>(budgetMicroseconds) ) {
+			// Out of time, leave the rest for the next call
+			numDeferred = numFinished;
+			mutex.unlock();
+			break;
+		}
+		PreloadTask *task = started.Front();
+		started.Pop();
+		numFinished--;
+		mutex.unlock();
+
+		// Merge it without holding the lock, so the workers can go on
 		if ( task->isLoaded )
 			task->Synchronize();
+		uLongLong taskEndTime = SysInfo::GetHiResTime();
+		uLongLong taskTime = taskEndTime - endTime;
+		endTime = taskEndTime;
+
+		syncStats.numTasks++;
+		syncStats.totalTime += taskTime;
+		if ( taskTime > syncStats.maxTime )
+			syncStats.maxTime = taskTime;
+
+		freedBytes += task->residentSize;
 		delete task;
-		preloaded.Pop();
-		numProcessed++;
+		num++;
+	}
+	numProcessed += num;
+	syncStats.lastTime = endTime - startTime;
+	syncStats.lastNumTasks = num;
+	syncStats.lastNumDeferred = numDeferred;
+
+	if ( num > 0 ) {
+		ogst::lock_guard<ogst::mutex> lock(mutex);
+		residentBytes -= freedBytes;
+		Dispatch();
 	}
+
 	if ( numTotal == 0 )
 		progress = 0.0f;
 	else
 		progress = static_cast<float>(numProcessed) / static_cast<float>(numTotal);
-	condition.Unlock();
-	condition.Signal();
-
 	return progress;
 }
 
@@ -159,7 +400,7 @@ PreloadManager::ResetProgress
 ================
 */
 void PreloadManager::ResetProgress( void ) {
-	// fixme: lock
+	ogst::lock_guard<ogst::mutex> lock(mutex);
 	progress = 0.0f;
 	numTotal -= numProcessed;
 	numProcessed = 0;
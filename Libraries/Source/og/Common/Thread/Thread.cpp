@@ -29,9 +29,32 @@ freely, subject to the following restrictions:
 
 #include <og/Common/Thread/Thread.h>
 #include <og/Common/Thread/ThreadLocalStorage.h>
+#include <og/Common/Thread/Atomic.h>
 
 namespace og {
-TLS_Index * lastTlsIndex = OG_NULL;
+static volatile int lastThreadSerial = 0;
+static TLS<int> threadSerial(0);
+
+// Releases the index of a thread together with its TLS data
+class ThreadIndex {
+public:
+	ThreadIndex() : index(-1) {}
+	~ThreadIndex();
+
+	int index;
+};
+static volatile int threadIndexInUse[Thread::MAX_INDICES];
+static TLS<ThreadIndex> threadIndex;
+
+/*
+================
+ThreadIndex::~ThreadIndex
+================
+*/
+ThreadIndex::~ThreadIndex() {
+	if ( index != -1 )
+		AtomicStoreRelease( &threadIndexInUse[index], 0 );
+}
 
 /*
 ================
@@ -39,11 +62,7 @@ TLS_AtExit
 ================
 */
 void TLS_AtExit( void ) {
-	if ( lastTlsIndex ) {
-		TLS_Data::Cleanup();
-		delete lastTlsIndex;
-		lastTlsIndex = OG_NULL;
-	}
+	TLS_Data::Cleanup();
 }
 
 /*
@@ -53,41 +72,33 @@ void TLS_AtExit( void ) {
 
 ==============================================================================
 */
+static volatile int numTlsSlots = 0;
+static volatile int tlsAtExitRegistered = 0;
+OG_THREAD_LOCAL TLS_Data *TLS_Data::slots[TLS_MAX_SLOTS];
+OG_THREAD_LOCAL TLS_Data *TLS_Data::lastData = OG_NULL;
+
 /*
 ================
 TLS_Data::TLS_Data
 ================
 */
-TLS_Data::TLS_Data( const TLS_Index *index ) : previous(OG_NULL), tlsIndex(index) {
-	tlsIndex->SetValue(this);
-	Register(this);
-}
+TLS_Data::TLS_Data( int slotIndex ) : previous(lastData), slot(slotIndex) {
+	// The main thread does not run through og::Thread, so clean it up at exit
+	if ( tlsAtExitRegistered == 0 && AtomicExchange( &tlsAtExitRegistered, 1 ) == 0 )
+		atexit( TLS_AtExit );
 
-/*
-================
-TLS_Data::~TLS_Data
-================
-*/
-TLS_Data::~TLS_Data() {
-	tlsIndex->SetValue(OG_NULL);
-	delete previous;
+	slots[slot] = this;
+	lastData = this;
 }
 
 /*
 ================
-TLS_Data::Register
+TLS_Data::AllocSlot
 ================
 */
-void TLS_Data::Register( TLS_Data *data ) {
-	if ( !lastTlsIndex ) {
-		lastTlsIndex = new TLS_Index;
-		OG_ASSERT( lastTlsIndex->IsValid() );
-		atexit( TLS_AtExit );
-	}
-
-	TLS_Data *lastTLS = static_cast<TLS_Data *>( lastTlsIndex->GetValue() );
-	data->previous = lastTLS;
-	lastTlsIndex->SetValue( data );
+int TLS_Data::AllocSlot( void ) {
+	int slot = AtomicIncrement( &numTlsSlots ) - 1;
+	return slot < TLS_MAX_SLOTS ? slot : -1;
 }
 
 /*
@@ -96,16 +107,12 @@ TLS_Data::Cleanup
 ================
 */
 void TLS_Data::Cleanup( void ) {
-	if ( lastTlsIndex == OG_NULL )
-		return;
-
-	TLS_Data *lastTLS = static_cast<TLS_Data *>( lastTlsIndex->GetValue() );
-	if ( lastTLS != OG_NULL ) {
-		delete lastTLS;
-#if OG_LINUX
-	#error "SegFault Here - FixMe"
-#endif
-		lastTlsIndex->SetValue( OG_NULL );
+	// Destructors might access other TLS objects, so always take the current last one
+	while( lastData != OG_NULL ) {
+		TLS_Data *data = lastData;
+		lastData = data->previous;
+		slots[data->slot] = OG_NULL;
+		delete data;
 	}
 }
 
@@ -116,57 +123,79 @@ void TLS_Data::Cleanup( void ) {
 
 ==============================================================================
 */
+// Number of times to check the state before going to sleep
+const int SHARED_MUTEX_SPINS = 100;
+
 /*
 ================
-SharedMutex::lock_shared
+SharedMutex::LockSharedSlow
 ================
 */
-void SharedMutex::lock_shared( void ) {
-	ogst::unique_lock<ogst::mutex> lock(mutex);
-	while( exclusiveRequests )
-		sharedCond.wait(lock);
-	numShared++;
+void SharedMutex::LockSharedSlow( void ) {
+	int spins = 0;
+	for(;;) {
+		int s = state;
+		if ( (s & ~READER_MASK) == 0 ) {
+			if ( AtomicCompareExchange( &state, s + 1, s ) == s )
+				return;
+		} else if ( spins < SHARED_MUTEX_SPINS ) {
+			spins++;
+			AtomicPause();
+		} else {
+			Park( WRITER | WAITING_MASK );
+			spins = 0;
+		}
+	}
 }
 
 /*
 ================
-SharedMutex::unlock_shared
+SharedMutex::LockSlow
 ================
 */
-void SharedMutex::unlock_shared( void ) {
-	mutex.lock();
-	numShared--;
-	if ( exclusiveRequests && numShared == 0 )
-		exclusiveCond.notify_one();
-	mutex.unlock();
+void SharedMutex::LockSlow( void ) {
+	// Announce ourself, so no new readers get in
+	AtomicAdd( &state, WRITER_WAITING );
+
+	int spins = 0;
+	for(;;) {
+		int s = state;
+		if ( (s & (WRITER | READER_MASK)) == 0 ) {
+			if ( AtomicCompareExchange( &state, s - WRITER_WAITING + WRITER, s ) == s )
+				return;
+		} else if ( spins < SHARED_MUTEX_SPINS ) {
+			spins++;
+			AtomicPause();
+		} else {
+			Park( WRITER | READER_MASK );
+			spins = 0;
+		}
+	}
 }
 
 /*
 ================
-SharedMutex::lock
+SharedMutex::Park
 ================
 */
-void SharedMutex::lock( void ) {
-	ogst::unique_lock<ogst::mutex> lock(mutex);
-	exclusiveRequests++;
-	while( exclusive )
-		exclusiveCond.wait(lock);
-	exclusiveRequests--;
-	exclusive = true;
-	lock.release();
+void SharedMutex::Park( int mask ) {
+	// numParked gets raised before checking the state, while the unlocking threads
+	// change the state before checking numParked, so one of us sees the other.
+	ogst::unique_lock<ogst::mutex> lock(parkMutex);
+	AtomicIncrement( &numParked );
+	while( (state & mask) != 0 )
+		parkCond.wait( lock );
+	AtomicDecrement( &numParked );
 }
 
 /*
 ================
-SharedMutex::unlock
+SharedMutex::WakeParked
 ================
 */
-void SharedMutex::unlock( void ) {
-	if ( exclusiveRequests > 0 )
-		exclusiveCond.notify_one();
-	else
-		sharedCond.notify_all();
-	mutex.unlock();
+void SharedMutex::WakeParked( void ) {
+	ogst::lock_guard<ogst::mutex> lock(parkMutex);
+	parkCond.notify_all();
 }
 
 /*
@@ -188,6 +217,7 @@ Thread::Thread() {
 	isRunning		= false;
 	keepRunning		= true;
 	nativeId		= 0;
+	affinityMask	= 0;
 }
 
 /*
@@ -197,6 +227,9 @@ Thread::Start
 */
 bool Thread::Start( const char *_name, bool waitForInit ) {
 	name = _name;
+
+	// Set it here already, so a Stop() before the thread got scheduled won't delete us
+	isRunning = true;
 	if ( !waitForInit ) {
 		thread = ogst::thread( &Thread::RunThread, this, (Condition *)OG_NULL );
 		return true;
@@ -255,5 +288,35 @@ void Thread::Stop( bool blocking ) {
 	}
 }
 
+/*
+================
+Thread::GetCurrentSerial
+================
+*/
+int Thread::GetCurrentSerial( void ) {
+	int *serial = threadSerial.Get();
+	if ( *serial == 0 )
+		*serial = AtomicIncrement( &lastThreadSerial );
+	return *serial;
+}
+
+/*
+================
+Thread::GetCurrentIndex
+================
+*/
+int Thread::GetCurrentIndex( void ) {
+	ThreadIndex *data = threadIndex.Get();
+	if ( data->index == -1 ) {
+		for( int i=0; i<MAX_INDICES; i++ ) {
+			if ( threadIndexInUse[i] == 0 && AtomicCompareExchange( &threadIndexInUse[i], 1, 0 ) == 0 ) {
+				data->index = i;
+				break;
+			}
+		}
+	}
+	return data->index;
+}
+
 }
 
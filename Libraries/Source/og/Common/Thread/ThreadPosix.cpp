@@ -30,10 +30,12 @@ freely, subject to the following restrictions:
 
 #include <og/Common/Thread/Thread.h>
 #include <og/Common/Thread/ThreadLocalStorage.h>
+#include <og/Common/Thread/Fiber.h>
 
 #if OG_LINUX || OG_MACOS_X
 
 #include <pthread.h>
+#include <ucontext.h>
 #include <sys/prctl.h>
 //#include <sys/types.h>
 #include <sys/syscall.h>
@@ -100,7 +102,95 @@ TLS_Index::SetValue
 */
 void TLS_Index::SetValue( void *value ) const {
 	OG_ASSERT( data != OG_NULL );
-	pthread_setspecific( *static_cast<pthread_key_t *>(data), data );
+	pthread_setspecific( *static_cast<pthread_key_t *>(data), value );
+}
+
+/*
+==============================================================================
+
+  Fiber
+
+==============================================================================
+*/
+struct FiberData {
+	ucontext_t			context;	// The fiber context
+	ucontext_t			caller;		// The context of the thread that entered
+	Fiber::fiberFunc_t	func;		// The entry function
+	void *				param;		// The entry parameter
+	byte *				stack;		// The fiber stack
+};
+
+/*
+================
+FiberStart
+
+makecontext only passes ints, so the pointer gets split up
+( shifted in two steps, so it's well defined on 32 bit too )
+================
+*/
+static void FiberStart( uInt low, uInt high ) {
+	size_t address = static_cast<size_t>(low) | ((static_cast<size_t>(high) << 16) << 16);
+	FiberData *fiberData = reinterpret_cast<FiberData *>(address);
+	fiberData->func( fiberData->param );
+	// Returning continues with uc_link ( the caller )
+}
+
+/*
+================
+Fiber::Fiber
+================
+*/
+Fiber::Fiber( fiberFunc_t func, void *param, int stackSize ) : data(OG_NULL) {
+	FiberData *fiberData = new FiberData;
+	if ( getcontext( &fiberData->context ) != 0 ) {
+		delete fiberData;
+		return;
+	}
+	fiberData->func = func;
+	fiberData->param = param;
+	fiberData->stack = new byte[stackSize];
+	fiberData->context.uc_stack.ss_sp = fiberData->stack;
+	fiberData->context.uc_stack.ss_size = stackSize;
+	fiberData->context.uc_link = &fiberData->caller;
+
+	size_t address = reinterpret_cast<size_t>(fiberData);
+	makecontext( &fiberData->context, reinterpret_cast<void (*)()>(FiberStart), 2,
+				static_cast<uInt>(address), static_cast<uInt>((address >> 16) >> 16) );
+	data = fiberData;
+}
+
+/*
+================
+Fiber::~Fiber
+================
+*/
+Fiber::~Fiber() {
+	if ( data ) {
+		FiberData *fiberData = static_cast<FiberData *>(data);
+		delete[] fiberData->stack;
+		delete fiberData;
+	}
+}
+
+/*
+================
+Fiber::Enter
+================
+*/
+void Fiber::Enter( void ) {
+	OG_ASSERT( data != OG_NULL );
+	FiberData *fiberData = static_cast<FiberData *>(data);
+	swapcontext( &fiberData->caller, &fiberData->context );
+}
+
+/*
+================
+Fiber::Leave
+================
+*/
+void Fiber::Leave( void ) {
+	FiberData *fiberData = static_cast<FiberData *>(data);
+	swapcontext( &fiberData->context, &fiberData->caller );
 }
 
 /*
@@ -126,6 +216,16 @@ void Thread::PlatformInit( void ) {
 		name.CapLength( i );
 
 	prctl(PR_SET_NAME, name.c_str(), 0, 0, 0, 0) ;
+
+	if ( affinityMask != 0 ) {
+		cpu_set_t set;
+		CPU_ZERO( &set );
+		for( int i=0; i<64; i++ ) {
+			if ( affinityMask & (static_cast<uLongLong>(1) << i) )
+				CPU_SET( i, &set );
+		}
+		pthread_setaffinity_np( pthread_self(), sizeof(set), &set );
+	}
 #elif OG_MACOS_X
 #warning "Need MacOS here FIXME"
 #endif
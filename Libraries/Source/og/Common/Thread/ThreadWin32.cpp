@@ -29,6 +29,7 @@ freely, subject to the following restrictions:
 
 #include <og/Common/Thread/Thread.h>
 #include <og/Common/Thread/ThreadLocalStorage.h>
+#include <og/Common/Thread/Fiber.h>
 
 #if OG_WIN32
 #include <windows.h>
@@ -88,6 +89,117 @@ void TLS_Index::SetValue( void *value ) const {
 	TlsSetValue( *static_cast<uLong *>(data), value );
 }
 
+/*
+==============================================================================
+
+  Fiber
+
+==============================================================================
+*/
+struct FiberData {
+	void *				handle;		// The fiber handle
+	void *				caller;		// The fiber of the thread that entered
+	Fiber::fiberFunc_t	func;		// The entry function
+	void *				param;		// The entry parameter
+};
+
+// The current thread converted to a fiber, converted back together with its TLS data
+class ThreadFiber {
+public:
+	ThreadFiber() : handle(OG_NULL), converted(false) {}
+	~ThreadFiber();
+
+	void *	handle;		// The fiber of this thread, NULL until it enters one
+	bool	converted;	// This thread was converted by us
+};
+static TLS<ThreadFiber> threadFiber;
+
+/*
+================
+ThreadFiber::~ThreadFiber
+================
+*/
+ThreadFiber::~ThreadFiber() {
+	if ( converted )
+		ConvertFiberToThread();
+}
+
+/*
+================
+FiberStart
+================
+*/
+static VOID CALLBACK FiberStart( LPVOID param ) {
+	FiberData *fiberData = static_cast<FiberData *>(param);
+	fiberData->func( fiberData->param );
+
+	// Returning would end the thread
+	for(;;)
+		SwitchToFiber( fiberData->caller );
+}
+
+/*
+================
+Fiber::Fiber
+================
+*/
+Fiber::Fiber( fiberFunc_t func, void *param, int stackSize ) : data(OG_NULL) {
+	FiberData *fiberData = new FiberData;
+	fiberData->caller = OG_NULL;
+	fiberData->func = func;
+	fiberData->param = param;
+	fiberData->handle = CreateFiber( stackSize, FiberStart, fiberData );
+	if ( fiberData->handle == OG_NULL )
+		delete fiberData;
+	else
+		data = fiberData;
+}
+
+/*
+================
+Fiber::~Fiber
+================
+*/
+Fiber::~Fiber() {
+	if ( data ) {
+		FiberData *fiberData = static_cast<FiberData *>(data);
+		DeleteFiber( fiberData->handle );
+		delete fiberData;
+	}
+}
+
+/*
+================
+Fiber::Enter
+================
+*/
+void Fiber::Enter( void ) {
+	OG_ASSERT( data != OG_NULL );
+
+	// Only fibers can switch to fibers
+	ThreadFiber *current = threadFiber.Get();
+	if ( current->handle == OG_NULL ) {
+		current->handle = ConvertThreadToFiber( OG_NULL );
+		if ( current->handle != OG_NULL )
+			current->converted = true;
+		else
+			current->handle = GetCurrentFiber(); // Already converted by someone else
+	}
+
+	FiberData *fiberData = static_cast<FiberData *>(data);
+	fiberData->caller = current->handle;
+	SwitchToFiber( fiberData->handle );
+}
+
+/*
+================
+Fiber::Leave
+================
+*/
+void Fiber::Leave( void ) {
+	SwitchToFiber( static_cast<FiberData *>(data)->caller );
+}
+
 /*
 ==============================================================================
 
@@ -105,6 +217,9 @@ void Thread::PlatformInit( void ) {
 	// Get native id
 	nativeId = GetCurrentThreadId();
 
+	if ( affinityMask != 0 )
+		SetThreadAffinityMask( GetCurrentThread(), static_cast<DWORD_PTR>(affinityMask) );
+
 	//! @todo   Not sure if this is microsoft specific or if just mingw needs something different
 #ifdef __MINGW32__
 	#warning "Need MinGW here FIXME"
@@ -45,7 +45,7 @@ FileEx::Close
 ================
 */
 void FileEx::Close( void ) {
-	static_cast<FileSystemEx *>(FS)->AddFileEvent( new FileTrackEvent( this, false ) );
+	static_cast<FileSystemEx *>(FS)->AddFileEvent( FileTrackEvent( this, false ) );
 }
 
 /*
@@ -155,7 +155,7 @@ FileBuffered::Close
 ================
 */
 void FileBuffered::Close( void ) {
-	static_cast<FileSystemEx *>(FS)->AddFileEvent( new LoadTrackEvent( data, false ) );
+	static_cast<FileSystemEx *>(FS)->AddFileEvent( FileTrackEvent( data, false ) );
 	FileEx::Close();
 }
 
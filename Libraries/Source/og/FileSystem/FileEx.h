@@ -70,7 +70,7 @@ namespace og {
 		const char *filename;		// filename only
 		String		fullpath;		// filename including path
 
-		friend class FileTrackEvent;
+		friend class FileTracker;
 		friend class PakFileEx;
 		friend class FileEventThread;
 	};
@@ -37,80 +37,55 @@ namespace og {
 FileSystem *FS = OG_NULL;
 TLS<bool> FileSystemEx::notFoundWarning(true);
 
-LinkedList<FileEx *> FileTrackEvent::list;
-List<byte *> LoadTrackEvent::list;
-
 /*
 ==============================================================================
 
-  FileTrackEvent
+  FileTracker
 
 ==============================================================================
 */
 /*
 ================
-FileTrackEvent::Execute
+FileTracker::operator()
 ================
 */
-void FileTrackEvent::Execute( void ) {
-	if ( doAdd ) {
-		list.AddToEnd( file );
-		file->node = list.GetLastNode();
+void FileTracker::operator()( const FileTrackEvent &evt ) {
+	if ( evt.file != OG_NULL ) {
+		if ( evt.doAdd ) {
+			files.AddToEnd( evt.file );
+			evt.file->node = files.GetLastNode();
+		} else {
+			files.Remove( evt.file->node );
+			delete evt.file;
+		}
+	} else if ( evt.doAdd ) {
+		buffers.Append( evt.buffer );
 	} else {
-		list.Remove( file->node );
-		delete file;
+		int index = buffers.Find( evt.buffer );
+		if ( index != -1 ) {
+			delete[] evt.buffer;
+			buffers.Remove( index );
+		}
 	}
 }
 
 /*
 ================
-FileTrackEvent::ClearAll
+FileTracker::ClearAll
 ================
 */
-void FileTrackEvent::ClearAll( void ) {
+void FileTracker::ClearAll( void ) {
 	//! @todo	The user should be notified if he left files open
-	LinkedList<FileEx *>::nodeType *node = list.GetFirstNode();
+	LinkedList<FileEx *>::nodeType *node = files.GetFirstNode();
 	while( node != OG_NULL ) {
 		delete node->value;
 		node = node->GetNext();
 	}
-	list.Clear();
-}
-
-/*
-==============================================================================
-
-  LoadTrackEvent
-
-==============================================================================
-*/
-/*
-================
-LoadTrackEvent::Execute
-================
-*/
-void LoadTrackEvent::Execute( void ) {
-	if ( doAdd )
-		list.Append( buffer );
-	else {
-		int index = list.Find( buffer );
-		if ( index != -1 ) {
-			delete[] buffer;
-			list.Remove( index );
-		}
-	}
-}
+	files.Clear();
 
-/*
-================
-LoadTrackEvent::ClearAll
-================
-*/
-void LoadTrackEvent::ClearAll( void ) {
-	//! @todo	The user should be notified if he left files open
-	for( int i=list.Num()-1; i >= 0; i-- )
-		delete[] list[i];
-	list.Clear();
+	for( int i=buffers.Num()-1; i >= 0; i-- )
+		delete[] buffers[i];
+	buffers.Clear();
 }
 
 /*
@@ -416,17 +391,16 @@ void FileSystemEx::Run( void ) {
 	// All this does is watch the open/close file events and on shutdown clear all files that where still open.
 	wakeUpEvent.Lock();
 	while( keepRunning ) {
-		eventQueue.ProcessAll();
+		eventBus.ProcessAll( fileTracker );
 		wakeUpEvent.Wait();
 	}
 	wakeUpEvent.Unlock();
 
 	// Consume remaining events
-	eventQueue.ProcessAll();
+	eventBus.ProcessAll( fileTracker );
 
 	// Elvis has left the building, clear all evidence
-	FileTrackEvent::ClearAll();
-	LoadTrackEvent::ClearAll();
+	fileTracker.ClearAll();
 
 	// This tape will selfdestruct in 0 seconds
 	CommonSetFileSystem( OG_NULL );
@@ -503,7 +477,7 @@ void FileSystemEx::AddResourceDir( const char *name, pfListId listId ) {
 		User::Warning( Format("Trying to add resource dir '$*' twice" ) << name );
 		return;
 	}
-	StringList files;
+	SmallStringList<8> files;
 	// Add to the list of resourceDirs
 	resourceDirs.Append( name );
 	int max = searchPaths.Num();
@@ -569,8 +543,7 @@ bool FileSystemEx::ChangeMod( const char *_modDir, const char *_modDirBase ) {
 	}
 
 	// Close all opened files
-	FileTrackEvent::ClearAll();
-	LoadTrackEvent::ClearAll();
+	fileTracker.ClearAll();
 
 	// Remove all resource directories, except the default(base) one
 	resourceDirs.Clear();
@@ -620,7 +593,7 @@ FileEx *FileSystemEx::OpenLocalFileRead( const char *filename, int *size ) {
 				if ( size != OG_NULL )
 					*size = fileEx->size;
 				
-				AddFileEvent( new FileTrackEvent( fileEx, true ) );
+				AddFileEvent( FileTrackEvent( fileEx, true ) );
 				return fileEx;
 			}
 		}
@@ -658,7 +631,7 @@ File *FileSystemEx::OpenRead( const char *filename, bool pure, bool buffered ) {
 		int i = fileEx->fullpath.ReverseFind("/");
 		fileEx->filename = fileEx->fullpath.c_str() + ((i == -1) ? 0 : i+1);
 
-		AddFileEvent( new FileTrackEvent( fileEx, true ) );
+		AddFileEvent( FileTrackEvent( fileEx, true ) );
 		return fileEx;
 	}
 
@@ -745,7 +718,7 @@ File *FileSystemEx::OpenWrite( const char *filename, bool pure ) {
 	int i = fileEx->fullpath.ReverseFind("/");
 	fileEx->filename = fileEx->fullpath.c_str() + ((i == -1) ? 0 : i+1);
 
-	static_cast<FileSystemEx *>(FS)->AddFileEvent( new FileTrackEvent( fileEx, true ) );
+	static_cast<FileSystemEx *>(FS)->AddFileEvent( FileTrackEvent( fileEx, true ) );
 
 	// Return the filehandle
 	return fileEx;
@@ -785,7 +758,7 @@ File *FileSystemEx::OpenAppend( const char *filename, bool pure ) {
 	int i = fileEx->fullpath.ReverseFind("/");
 	fileEx->filename = fileEx->fullpath.c_str() + ((i == -1) ? 0 : i+1);
 
-	static_cast<FileSystemEx *>(FS)->AddFileEvent( new FileTrackEvent( fileEx, true ) );
+	static_cast<FileSystemEx *>(FS)->AddFileEvent( FileTrackEvent( fileEx, true ) );
 
 	// Return the filehandle
 	return fileEx;
@@ -971,7 +944,7 @@ int FileSystemEx::LoadFile( const char *path, byte **buffer, bool pure, String *
 		// Just in case we are reading a text file, terminate the buffer
 		(*buffer)[size] = 0;
 
-		AddFileEvent( new LoadTrackEvent( *buffer, true ) );
+		AddFileEvent( FileTrackEvent( *buffer, true ) );
 		file->Close();
 		return size;
 	}
@@ -992,7 +965,7 @@ Free a file that has been loaded with LoadFile()
 ============
 */
 void FileSystemEx::FreeFile( byte *buffer ) {
-	AddFileEvent( new LoadTrackEvent( buffer, false ) );
+	AddFileEvent( FileTrackEvent( buffer, false ) );
 }
 
 /*
@@ -1281,7 +1254,7 @@ ModList *FileSystemEx::GetModList( void ) {
 	String description;
 	ModListEx *mods = new ModListEx;
 	for( int i=searchPaths.Num()-1; i >= 0; i-- ) {
-		StringList directories;
+		SmallStringList<16> directories;
 		LocalFileSearch( searchPaths[i].c_str(), "", "", &directories, LF_DIRS );
 		for( int j=0; j<directories.Num(); j++ ) {
 			directories[j].StripTrailingOnce("/");
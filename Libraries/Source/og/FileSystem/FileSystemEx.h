@@ -48,36 +48,35 @@ namespace og {
 
 	==============================================================================
 	*/
-	class FileTrackEvent : public QueuedEvent {
+	class FileTrackEvent {
 	public:
-		FileTrackEvent( FileEx *f, bool add ) : file(f), doAdd(add) { OG_ASSERT(f != OG_NULL); }
-		void	Execute( void );
+		FileTrackEvent() : file(OG_NULL), buffer(OG_NULL), doAdd(false) {}
+		FileTrackEvent( FileEx *f, bool add ) : file(f), buffer(OG_NULL), doAdd(add) { OG_ASSERT(f != OG_NULL); }
+		FileTrackEvent( byte *b, bool add ) : file(OG_NULL), buffer(b), doAdd(add) {}
 
-		static void	ClearAll( void );
 	private:
+		friend class FileTracker;
+
 		FileEx	*	file;
+		byte	*	buffer;
 		bool		doAdd;
-
-		static LinkedList<FileEx *> list;	// Keeps track of opened filed to close them later
 	};
 
 	/*
 	==============================================================================
 
-	  LoadTrackEvent
+	  FileTracker
 
 	==============================================================================
 	*/
-	class LoadTrackEvent : public QueuedEvent {
+	class FileTracker {
 	public:
-		LoadTrackEvent( byte *b, bool add ) : buffer(b), doAdd(add) {}
-		void	Execute( void );
+		void	operator()( const FileTrackEvent &evt );
+		void	ClearAll( void );
 
-		static void	ClearAll( void );
 	private:
-		byte	*	buffer;
-		bool		doAdd;
-		static List<byte *> list;	// Same as above for file buffers
+		LinkedList<FileEx *> files;		// Keeps track of opened filed to close them later
+		List<byte *>	buffers;		// Same as above for file buffers
 	};
 
 	/*
@@ -125,7 +124,7 @@ namespace og {
 		FileSystemEx();
 
 		// moved from fileeventthread
-		void	AddFileEvent( QueuedEvent *evt ) { eventQueue.Add( evt ); WakeUp(); }
+		void	AddFileEvent( const FileTrackEvent &evt ) { eventBus.Add( evt ); WakeUp(); }
 
 	protected:
 		void	Run( void );
@@ -174,7 +173,8 @@ namespace og {
 		bool			pureMode;					// Pure mode enabled (like sv_pure in quake3)
 		StringList		pureExtensions;				// Extensions allowed when pure mode is enabled
 
-		EventQueue				eventQueue;			// File event queue
+		EventBus<FileTrackEvent> eventBus;			// File event bus
+		FileTracker		fileTracker;				// Processes the file events
 	};
 }
 
@@ -50,7 +50,7 @@ namespace og {
 */
 class FileFinder {
 public:
-	FileFinder( const char *_baseDir, const char *_extension, StringList *_list, int flags ) {
+	FileFinder( const char *_baseDir, const char *_extension, fileSearchCB_t _callback, void *_param, int flags ) {
 #if OG_WIN32
 		StringToWide( _baseDir, baseDir );
 		StringToWide( _extension, extension );
@@ -58,7 +58,8 @@ public:
 		baseDir = _baseDir;
 		extension = _extension;
 #endif
-		list		= _list;
+		callback	= _callback;
+		param		= _param;
 		addDirs		= (flags & LF_DIRS) != 0;
 		addFiles	= (flags & LF_FILES) != 0;
 		recursive	= (flags & LF_CHECK_SUBDIRS) != 0;
@@ -95,7 +96,7 @@ public:
 				wfilename += L"/";
 				if ( addDirs ) {
 					filename.FromWide( wfilename.c_str() );
-					list->Append( filename );
+					callback( param, filename );
 				}
 				if ( recursive )
 					SearchDir( wfilename.c_str() );
@@ -104,7 +105,7 @@ public:
 				wfilename = dir;
 				wfilename += findData.cFileName;
 				filename.FromWide( wfilename.c_str() );
-				list->Append( filename );
+				callback( param, filename );
 			}
 		} while( FindNextFile(hFind, &findData) != 0 );
 
@@ -150,12 +151,12 @@ public:
 				filename = name;
 				filename += "/";
 				if ( addDirs )
-					list->Append( filename );
+					callback( param, filename );
 				if ( recursive )
 					SearchDir( filename.c_str() );
 			}
 			else if ( addFiles )
-				list->Append( name );
+				callback( param, name );
 		}
 
 		globfree( &findResult );
@@ -166,7 +167,8 @@ public:
 private:
 	bool			addDirs, addFiles;
 	bool			recursive;
-	StringList *	list;
+	fileSearchCB_t	callback;
+	void *			param;
 
 #if OG_WIN32
 	DynBuffer<wchar_t>	baseDir;
@@ -182,7 +184,7 @@ private:
 LocalFileSearch
 ================
 */
-bool LocalFileSearch( const char *baseDir, const char *dir, const char *extension, StringList *list, int flags ) {
+bool LocalFileSearch( const char *baseDir, const char *dir, const char *extension, fileSearchCB_t callback, void *param, int flags ) {
 	String baseDirWithSlash = baseDir;
 	if( !baseDirWithSlash.IsEmpty() ) {
 		if( baseDirWithSlash.CmpSuffix("/") != 0 )
@@ -193,7 +195,7 @@ bool LocalFileSearch( const char *baseDir, const char *dir, const char *extensio
 		if( dirWithSlash.CmpSuffix("/") != 0 )
 			dirWithSlash += "/";
 	}
-	FileFinder finder( baseDirWithSlash.c_str(), extension, list, flags );
+	FileFinder finder( baseDirWithSlash.c_str(), extension, callback, param, flags );
 
 #if OG_WIN32
 	DynBuffer<wchar_t> strDir;
@@ -60,7 +60,18 @@ namespace og {
 		StringList		files;
 	};
 	
-	bool LocalFileSearch( const char *baseDir, const char *dir, const char *extension, StringList *list, int flags );
+	typedef void (*fileSearchCB_t)( void *param, const String &filename );
+	bool LocalFileSearch( const char *baseDir, const char *dir, const char *extension, fileSearchCB_t callback, void *param, int flags );
+
+	// Lets the search fill any list with an Append( const String & ) method
+	template<class listType>
+	void LocalFileSearchAppend( void *param, const String &filename ) {
+		static_cast<listType *>( param )->Append( filename );
+	}
+	template<class listType>
+	OG_INLINE bool LocalFileSearch( const char *baseDir, const char *dir, const char *extension, listType *list, int flags ) {
+		return LocalFileSearch( baseDir, dir, extension, LocalFileSearchAppend<listType>, list, flags );
+	}
 }
 
 #endif
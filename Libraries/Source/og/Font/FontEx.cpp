@@ -38,7 +38,8 @@ OG_INLINE void FontSetColor( const Color &color ) { glColor4f( color.r, color.g,
 
 //! @todo	make thread safe
 static float screenScale = 1.0f;
-static DictEx<FontFamily> fontFamilies;
+static SlotMap<FontFamily *> fontFamilies;
+static HashIndex familyHash;	// Hash of the family names to the index in fontFamilies
 static FontFamily *defaultFamily = OG_NULL;
 static LinkedList<FontEx> fontList;
 
@@ -584,19 +585,45 @@ FontFamily::Find
 */
 FontFamily *FontFamily::Find( const char *name ) {
 	OG_ASSERT( name != OG_NULL );
-	int index = fontFamilies.Find( name );
-	if ( index == -1 ) {
-		FontFamily &font = fontFamilies[name];
-		// try allocating it
-		if ( !font.Open( name ) ) {
-			fontFamilies.Remove( name );
-			return defaultFamily;
+	int hash = HashIndex::GenerateKey( name, false );
+	for ( int i = familyHash.First( hash ); i != -1; i = familyHash.Next() ) {
+		if ( fontFamilies[i]->name.Icmp( name ) == 0 ) {
+			fontFamilies[i]->numUsers++;
+			return fontFamilies[i];
 		}
-		font.numUsers = 1;
-		return &font;
 	}
-	fontFamilies[index].numUsers++;
-	return &fontFamilies[index];
+
+	// try allocating it
+	FontFamily *font = new FontFamily;
+	if ( !font->Open( name ) ) {
+		delete font;
+		return defaultFamily;
+	}
+	font->name = name;
+	font->numUsers = 1;
+	familyHash.Add( hash, fontFamilies.Num() );
+	font->handle = fontFamilies.Add( font );
+	return font;
+}
+
+/*
+================
+FontFamily::Free
+
+The last family takes the place of the removed one,
+so its hash entry needs to be moved as well.
+================
+*/
+void FontFamily::Free( FontFamily *family ) {
+	int index = fontFamilies.GetIndex( family->handle );
+	OG_ASSERT( index != -1 && fontFamilies[index] == family );
+
+	int last = fontFamilies.Num() - 1;
+	familyHash.RemoveFast( HashIndex::GenerateKey( family->name.c_str(), false ), index );
+	if ( index != last )
+		familyHash.Move( HashIndex::GenerateKey( fontFamilies[last]->name.c_str(), false ), last, index );
+	fontFamilies.Remove( family->handle );
+	delete family;
 }
 
 /*
@@ -707,7 +734,11 @@ Font::Shutdown
 */
 void Font::Shutdown( void ) {
 	fontList.Clear();
+	int num = fontFamilies.Num();
+	for( int i=0; i<num; i++ )
+		delete fontFamilies[i];
 	fontFamilies.Clear();
+	familyHash.Clear();
 	defaultFamily = OG_NULL;
 	fontFS = OG_NULL;
 }
@@ -745,21 +776,16 @@ void Font::Free( Font *font ) {
 	OG_ASSERT( font != OG_NULL );
 
 	FontEx *fontEx = static_cast<FontEx *>(font);
+	FontFamily *family = fontEx->family;
+
+	// The destructor of fontEx releases its use of the family
+	fontList.Remove( fontEx->node );
 
 	// No need to keep font families that are no longer in use.
-	// Remember, defaultFamily is always occupied with at least one user,
-	// which is correct, since we always want it to be available.
+	// defaultFamily is always kept, since we always want it to be available.
 	// It will be freed upon Font::Shutdown.
-	if ( fontEx->family->numUsers == 0 ) {
-		int num = fontFamilies.Num();
-		for( int i=0; i<num; i++ ) {
-			if ( &fontFamilies[i] == fontEx->family ) {
-				fontFamilies.Remove(i);
-				break;
-			}
-		}
-	}
-	fontList.Remove( fontEx->node );
+	if ( family->numUsers == 0 && family != defaultFamily )
+		FontFamily::Free( family );
 }
 
 }
@@ -163,11 +163,20 @@ namespace og {
 		// ==============================================================================
 		static FontFamily *	Find( const char *name );
 
+		// ==============================================================================
+		//! Remove a family, which is no longer in use, from the cache and delete it
+		//!
+		//! @param	family	The family to free
+		// ==============================================================================
+		static void		Free( FontFamily *family );
+
 	private:
 		friend class	FontEx;
 		friend class	Font;
 		ListEx<FontFile> fontFiles;			//!< All font files belonging to this family
 		int				numUsers;			//!< How many times this family is currently in use.
+		String			name;				//!< Family name
+		uInt			handle;				//!< Handle in the family list
 	};
 
 	// ==============================================================================
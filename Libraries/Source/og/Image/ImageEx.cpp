@@ -52,13 +52,14 @@ int		ImageEx::magFilter = GL_LINEAR;
 int		ImageEx::maxTextureSize = 256;
 int		ImageEx::jpegQuality = 90;
 
-static DictEx<ImageEx> imageList;
+static SlotMap<ImageEx *> imageList;
+static HashIndex imageHash;		// Hash of the image names to the index in imageList
 static DictEx<ImageFile *> imageFileTypes;
 static Image *defaultImage = OG_NULL;
 
 class ImagePreloadTask : public PreloadTask {
 public:
-	ImagePreloadTask( const char *_filename ) : filename(_filename), file(OG_NULL) {}
+	ImagePreloadTask( const char *_filename, uInt _handle ) : filename(_filename), handle(_handle), file(OG_NULL) {}
 	~ImagePreloadTask() {
 		delete file;
 	}
@@ -73,16 +74,36 @@ public:
 		}
 		return false;
 	}
+	uLongLong	GetResidentSize( void ) const {
+		return file ? file->GetResidentSize() : 0;
+	}
+	uLongLong	GetEstimatedSize( void ) const {
+		// Compressed formats decode to more than this, but it's a cheap lower bound
+		int size = imageFS->FileSize( filename.c_str() );
+		return size > 0 ? size : 0;
+	}
 	void	Synchronize( void ) {
 		if ( file ) {
-			ImageEx &img = imageList[filename.c_str()];
-			if ( file->Upload( img ) )
-				img.time = imageFS->FileTime( filename.c_str() );
+			ImageEx *img;
+			if ( handle != SlotMap<ImageEx *>::INVALID_HANDLE ) {
+				// The image might have been freed while we were loading
+				ImageEx **entry = imageList.Get( handle );
+				if ( entry == OG_NULL )
+					return;
+				img = *entry;
+			} else {
+				img = ImageEx::FindImage( filename.c_str() );
+				if ( img == OG_NULL )
+					img = ImageEx::AddImage( filename.c_str() );
+			}
+			if ( file->Upload( *img ) )
+				img->time = imageFS->FileTime( filename.c_str() );
 		}
 	}
 
 private:
 	String filename;
+	uInt handle;
 	ImageFile *file;
 };
 
@@ -133,7 +154,11 @@ Image::Shutdown
 ================
 */
 void Image::Shutdown( void ) {
+	int num = imageList.Num();
+	for( int i=0; i<num; i++ )
+		delete imageList[i];
 	imageList.Clear();
+	imageHash.Clear();
 	imageFileTypes.Clear();
 	defaultImage = OG_NULL;
 	imageFS = OG_NULL;
@@ -151,7 +176,7 @@ uInt Image::ReloadImages( bool force, PreloadManager *preloadManager ) {
 	uInt numReloads = 0;
 	int num = imageList.Num();
 	for( int i=0; i<num; i++ ) {
-		if ( imageList[i].ReloadImage( force, preloadManager ) )
+		if ( imageList[i]->ReloadImage( force, preloadManager ) )
 			numReloads++;
 	}
 
@@ -167,13 +192,13 @@ Image *Image::Find( const char *filename ) {
 	if ( filename[0] == '\0' )
 		return defaultImage;
 
-	int index = imageList.Find( filename );
-	if ( index != -1 )
-		return &imageList[index];
+	ImageEx *img = ImageEx::FindImage( filename );
+	if ( img != OG_NULL )
+		return img;
 
-	ImageEx *img = &imageList[filename];
+	img = ImageEx::AddImage( filename );
 	if ( !img->UploadImage( filename ) ) {
-		imageList.Remove( imageList.Find( filename ) );
+		ImageEx::FreeImage( img );
 		return defaultImage;
 	}
 	return img;
@@ -184,14 +209,9 @@ Image::Free
 ================
 */
 void Image::Free( Image *image ) {
-	//! @todo	can this be done nicer ?
-	int max = imageList.Num();
-	for( int i=0; i<max; i++ ) {
-		if ( &imageList[i] == image ) {
-			imageList.Remove(i);
-			return;
-		}
-	}
+	OG_ASSERT( image != OG_NULL );
+	if ( image != defaultImage )
+		ImageEx::FreeImage( static_cast<ImageEx *>(image) );
 }
 
 /*
@@ -244,7 +264,7 @@ void Image::SetFilters( int min, int mag ) {
 	// Update filters for all images.
 	int num = imageList.Num();
 	for( int i=0; i<num; i++ ) {
-		ImageEx &img = imageList[i];
+		ImageEx &img = *imageList[i];
 		if ( img.mipmap ) {
 			img.BindTexture();
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, ImageEx::minFilter);
@@ -277,7 +297,7 @@ Image::PreloadImage
 ================
 */
 PreloadTask *Image::PreloadImage( const char *filename ) {
-	return new ImagePreloadTask(filename);
+	return new ImagePreloadTask( filename, SlotMap<ImageEx *>::INVALID_HANDLE );
 }
 
 /*
@@ -346,7 +366,7 @@ bool ImageEx::ReloadImage( bool force, PreloadManager *preloadManager ) {
 		return false;
 	}
 	if ( preloadManager != OG_NULL ) {
-		preloadManager->AddTask( new ImagePreloadTask(fullpath.c_str()) );
+		preloadManager->AddTask( new ImagePreloadTask( fullpath.c_str(), handle ) );
 		return true;
 	}
 	if ( !imageFileTypes[index]->Open( fullpath.c_str() ) )
@@ -385,6 +405,53 @@ int ImageEx::GetFileTypeIndex( String &filename ) {
 	return index;
 }
 
+/*
+================
+ImageEx::FindImage
+================
+*/
+ImageEx *ImageEx::FindImage( const char *name ) {
+	int hash = HashIndex::GenerateKey( name, false );
+	for ( int i = imageHash.First( hash ); i != -1; i = imageHash.Next() ) {
+		if ( imageList[i]->name.Icmp( name ) == 0 )
+			return imageList[i];
+	}
+	return OG_NULL;
+}
+
+/*
+================
+ImageEx::AddImage
+================
+*/
+ImageEx *ImageEx::AddImage( const char *name ) {
+	ImageEx *img = new ImageEx;
+	img->name = name;
+	imageHash.Add( HashIndex::GenerateKey( name, false ), imageList.Num() );
+	img->handle = imageList.Add( img );
+	return img;
+}
+
+/*
+================
+ImageEx::FreeImage
+
+The last image takes the place of the removed one,
+so its hash entry needs to be moved as well.
+================
+*/
+void ImageEx::FreeImage( ImageEx *img ) {
+	int index = imageList.GetIndex( img->handle );
+	OG_ASSERT( index != -1 && imageList[index] == img );
+
+	int last = imageList.Num() - 1;
+	imageHash.RemoveFast( HashIndex::GenerateKey( img->name.c_str(), false ), index );
+	if ( index != last )
+		imageHash.Move( HashIndex::GenerateKey( imageList[last]->name.c_str(), false ), last, index );
+	imageList.Remove( img->handle );
+	delete img;
+}
+
 /*
 ==============================================================================
 
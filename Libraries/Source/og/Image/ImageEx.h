@@ -68,7 +68,12 @@ namespace og {
 		bool	ReloadImage( bool force, PreloadManager *preloadManager=OG_NULL );
 		
 		static int	GetFileTypeIndex( String &filename );
+		static ImageEx *FindImage( const char *name );
+		static ImageEx *AddImage( const char *name );
+		static void	FreeImage( ImageEx *image );
 
+		String	name;
+		uInt	handle;
 		String	fullpath;
 		uInt	glTextureNum;
 		uInt	width, height;
@@ -101,6 +106,7 @@ namespace og {
 		virtual bool	Upload( ImageEx &image ) = 0;
 
 		virtual ImageFile *GetNew( void ) = 0;
+		virtual uLongLong	GetResidentSize( void ) const = 0;
 
 	protected:
 		uInt	width;
@@ -120,6 +126,7 @@ namespace og {
 		ImageFileNoDXT() { curBuffer = 0; }
 
 		bool	Upload( ImageEx &image );
+		uLongLong	GetResidentSize( void ) const { return dynBuffers[0].size + dynBuffers[1].size; }
 
 	protected:
 		bool	hasAlpha;
@@ -195,6 +202,7 @@ namespace og {
 		bool	Upload( ImageEx &image );
 
 		ImageFile *GetNew( void ) { return new ImageFileDDS; }
+		uLongLong	GetResidentSize( void ) const { return dynBuffer.size; }
 
 	private:
 		uInt	dxtFormat;
@@ -0,0 +1,168 @@
+/*
+===========================================================================
+The Open Game Libraries.
+Copyright (C) 2007-2010 Lusito Software
+
+Author:  Santo Pfingsten (TTK-Bandit)
+Purpose: Small random number streams ( PCG32 and xoshiro128** )
+-----------------------------------------
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+===========================================================================
+*/
+
+#include <og/Math.h>
+
+namespace og {
+
+/*
+==============================================================================
+
+  RandomPCG
+
+==============================================================================
+*/
+
+/*
+================
+RandomPCG::SetSeed
+================
+*/
+void RandomPCG::SetSeed( uLongLong seed, uLongLong stream ) {
+	state = 0;
+	increment = (stream << 1) | 1;
+	RandomUInt();
+	state += seed;
+	RandomUInt();
+}
+
+/*
+================
+RandomPCG::SeedTime
+================
+*/
+void RandomPCG::SeedTime( uLongLong stream ) {
+	SetSeed( static_cast<uLongLong>(SysInfo::GetTime()), stream );
+}
+
+/*
+================
+RandomPCG::Advance
+
+Brown, "Random Number Generation with Arbitrary Stride"
+================
+*/
+void RandomPCG::Advance( uLongLong delta ) {
+	uLongLong curMult = PCG_MULTIPLIER;
+	uLongLong curPlus = increment;
+	uLongLong accMult = 1;
+	uLongLong accPlus = 0;
+	while( delta > 0 ) {
+		if ( delta & 1 ) {
+			accMult *= curMult;
+			accPlus = accPlus * curMult + curPlus;
+		}
+		curPlus = (curMult + 1) * curPlus;
+		curMult *= curMult;
+		delta >>= 1;
+	}
+	state = accMult * state + accPlus;
+}
+
+/*
+==============================================================================
+
+  RandomXoshiro
+
+==============================================================================
+*/
+static const uInt xoshiroJump[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+static const uInt xoshiroLongJump[4] = { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+
+/*
+================
+RandomXoshiro::SetSeed
+
+Expands the seed with splitmix64, so the state never ends up all zero
+================
+*/
+void RandomXoshiro::SetSeed( uLongLong seed ) {
+	for( int i=0; i<4; i+=2 ) {
+		seed += 0x9e3779b97f4a7c15ULL;
+		uLongLong z = seed;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		z ^= z >> 31;
+		s[i] = static_cast<uInt>(z);
+		s[i+1] = static_cast<uInt>(z >> 32);
+	}
+}
+
+/*
+================
+RandomXoshiro::SeedTime
+================
+*/
+void RandomXoshiro::SeedTime( void ) {
+	SetSeed( static_cast<uLongLong>(SysInfo::GetTime()) );
+}
+
+/*
+================
+RandomXoshiro::JumpBy
+================
+*/
+void RandomXoshiro::JumpBy( const uInt *table ) {
+	uInt s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	for( int i=0; i<4; i++ ) {
+		for( int b=0; b<32; b++ ) {
+			if ( table[i] & (1u << b) ) {
+				s0 ^= s[0];
+				s1 ^= s[1];
+				s2 ^= s[2];
+				s3 ^= s[3];
+			}
+			RandomUInt();
+		}
+	}
+	s[0] = s0;
+	s[1] = s1;
+	s[2] = s2;
+	s[3] = s3;
+}
+
+/*
+================
+RandomXoshiro::Jump
+================
+*/
+void RandomXoshiro::Jump( void ) {
+	JumpBy( xoshiroJump );
+}
+
+/*
+================
+RandomXoshiro::LongJump
+================
+*/
+void RandomXoshiro::LongJump( void ) {
+	JumpBy( xoshiroLongJump );
+}
+
+}
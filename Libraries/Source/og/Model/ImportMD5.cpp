@@ -150,8 +150,7 @@ bool ImportMD5AnimBaseFrame( const char *filename, Model *model ) {
 				} else if ( String::Icmp( p, "numJoints" ) == 0 ) {
 					numJoints = lexer.ReadInt();
 					if ( numJoints > 0 ) {
-						model->bones.SetGranularity( numJoints );
-						model->bones.CheckSize( numJoints );
+						model->bones.Reserve( numJoints );
 					}
 				} else if ( String::Icmp( p, "numFrames" ) == 0 ) {
 					numFrames = lexer.ReadInt();
@@ -282,7 +281,7 @@ Model *Model::ImportMD5( const char *filename, const char *filenameAnim ) {
 				} else if ( readMeshTris ) {
 					if ( lexer.CheckToken( "numweights" ) ) {
 						numWeights = lexer.ReadInt();
-						weightList.CheckSize( numWeights );
+						weightList.Reserve( numWeights );
 						readMeshTris = false;
 						continue;
 					}
@@ -353,15 +352,13 @@ Model *Model::ImportMD5( const char *filename, const char *filenameAnim ) {
 				} else if ( String::Icmp( p, "numJoints" ) == 0 ) {
 					numJoints = lexer.ReadInt();
 					if ( numJoints > 0 ) {
-						model->bones.SetGranularity( numJoints );
-						model->bones.CheckSize( numJoints );
+						model->bones.Reserve( numJoints );
 					}
 				} else if ( String::Icmp( p, "numMeshes" ) == 0 ) {
 					numMeshes = lexer.ReadInt();
 					if ( numMeshes <= 0 )
 						lexer.Error("Zero meshes");
-					model->meshes.SetGranularity( numMeshes );
-					model->meshes.CheckSize( numMeshes );
+					model->meshes.Reserve( numMeshes );
 				} else if ( String::Icmp( p, "joints" ) == 0 ) {
 					if ( numJoints == -1 )
 						lexer.Error( "numJoins not set!" );
@@ -406,7 +403,7 @@ Model *Model::ImportMD5( const char *filename, const char *filenameAnim ) {
 					numVerts = lexer.ReadInt();
 
 					vertexList.Clear();
-					vertexList.CheckSize( numVerts );
+					vertexList.Reserve( numVerts );
 					weightList.Clear();
 					InitVertices( mesh, numVerts );
 					inMeshGroup = true;
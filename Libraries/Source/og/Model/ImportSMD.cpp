@@ -141,6 +141,7 @@ Model *LoadSMD( const char *filename, ListEx<smdMesh_t> &smdMeshes ) {
 						mesh.name = Format("mesh $*") << index;
 						mesh.materialName = material;
 						mesh.vertices.SetGranularity(128);
+						mesh.vertices.SetGeometricGrowth(true);
 					}
 					smdMesh_t &mesh = smdMeshes[index];
 
@@ -167,8 +168,7 @@ Model *LoadSMD( const char *filename, ListEx<smdMesh_t> &smdMeshes ) {
 							// No line change, so this token is the numWeights param
 							numWeights = lexer.ReadInt();
 
-							vert.weights.SetGranularity(numWeights);
-							vert.weights.CheckSize(numWeights);
+							vert.weights.Reserve(numWeights);
 							for( j=0; j<numWeights; j++ ) {
 								smdWeight_t &weight = vert.weights.Alloc();
 								weight.jointId = lexer.ReadInt();
@@ -176,7 +176,7 @@ Model *LoadSMD( const char *filename, ListEx<smdMesh_t> &smdMeshes ) {
 							}
 						} else {
 							// Line has changed, so no weights are present.. add a default weight
-							vert.weights.SetGranularity(1);
+							vert.weights.Reserve(1);
 							smdWeight_t &weight = vert.weights.Alloc();
 							weight.jointId = vert.jointId;
 							weight.influence = 1.0f;
@@ -246,6 +246,7 @@ Model *Model::ImportSMD( const char *filename ) {
 		InitVertices( mesh, numVertices );
 		addedVertices = 0;
 		indices.Clear();
+		indices.Reserve( numVertices );
 
 		for( j=0; j<numVertices; j++ ) {
 			smdVertex_t &vert = smdMesh.vertices[j];
@@ -339,7 +339,7 @@ void String::ToLower( void ) {
 	int len;
 	String old(*this);
 	Empty();
-	for( int i=0; i<old.byteLength; i++ ) {
+	for( int i=0; i<old.byteLength; i+=len ) {
 		ch = Utf8ToWChar( old.data+i, &len );
 		WCharToUtf8( towlower(ch), utf8 );
 		AppendData( utf8, ByteLength(utf8), 1 );
@@ -357,7 +357,7 @@ void String::ToUpper( void ) {
 	int len;
 	String old(*this);
 	Empty();
-	for( int i=0; i<old.byteLength; i++ ) {
+	for( int i=0; i<old.byteLength; i+=len ) {
 		ch = Utf8ToWChar( old.data+i, &len );
 		WCharToUtf8( towupper(ch), utf8 );
 		AppendData( utf8, ByteLength(utf8), 1 );
@@ -1175,7 +1175,7 @@ void String::SetData( const char *text, int byteLen, int len ) {
 
 	CheckSize( byteLen + 1, false );
 	memcpy( data, text, byteLen );
-	data[len] = '\0';
+	data[byteLen] = '\0';
 	byteLength = byteLen;
 	length = len;
 }
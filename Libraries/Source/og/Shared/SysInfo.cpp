@@ -28,13 +28,16 @@ freely, subject to the following restrictions:
 */
 
 #include <cstdio>
+#include <cstdlib>
 #include <og/Shared.h>
 
 #if OG_WIN32
 	#include <windows.h>
 #elif OG_LINUX
 	#include <dlfcn.h>
+	#include <sched.h>
 	#include <sys/time.h>
+	#include <unistd.h>
 #elif OG_MACOS_X
 	#warning "Need MacOS here FIXME"
 #endif
@@ -48,6 +51,7 @@ static double		pfcMultiplier;
 #endif
 
 CPU::Features	cpu;
+CPU::Topology	topology;
 uLongLong		ramB; // in bytes
 uLongLong		ramMB; // in MByte
 
@@ -501,6 +505,182 @@ bool GetOSInfo( OSInfo &data ) {
 	return false;
 }
 
+#if OG_LINUX
+/*
+================
+ReadSysFile
+
+Read the first line of a sysfs file
+================
+*/
+static bool ReadSysFile( const char *path, char *buffer, int size ) {
+	FILE *file = fopen( path, "r" );
+	if ( file == OG_NULL )
+		return false;
+	int len = fread( buffer, 1, size-1, file );
+	fclose( file );
+	if ( len <= 0 )
+		return false;
+	buffer[len] = '\0';
+	return true;
+}
+#endif
+
+/*
+================
+SysInfo::RetrieveTopology
+================
+*/
+void RetrieveTopology( void ) {
+	// Defaults, in case the os can't tell: every processor is a core on one node
+	topology.numLogical = 1;
+	topology.numCores = 0;
+	topology.numNodes = 0;
+	topology.usable = 0;
+	for( int i=0; i<CPU::Topology::MAX_LOGICAL; i++ ) {
+		topology.core[i] = -1;
+		topology.node[i] = -1;
+	}
+
+#if OG_WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	topology.numLogical = info.dwNumberOfProcessors;
+	if ( topology.numLogical > CPU::Topology::MAX_LOGICAL )
+		topology.numLogical = CPU::Topology::MAX_LOGICAL;
+
+	DWORD_PTR processMask, systemMask;
+	if ( GetProcessAffinityMask( GetCurrentProcess(), &processMask, &systemMask ) )
+		topology.usable = processMask;
+
+	// Not available before XP SP3
+	typedef BOOL (WINAPI *glpiProc_t)( PSYSTEM_LOGICAL_PROCESSOR_INFORMATION, PDWORD );
+	glpiProc_t glpi = reinterpret_cast<glpiProc_t>( GetProcAddress( GetModuleHandleA("kernel32"), "GetLogicalProcessorInformation" ) );
+	DWORD size = 0;
+	if ( glpi != OG_NULL && !glpi( OG_NULL, &size ) && GetLastError() == ERROR_INSUFFICIENT_BUFFER ) {
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION *buffer = static_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION *>( malloc( size ) );
+		if ( buffer != OG_NULL && glpi( buffer, &size ) ) {
+			int num = size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+			for( int i=0; i<num; i++ ) {
+				int *target;
+				int value;
+				if ( buffer[i].Relationship == RelationProcessorCore ) {
+					target = topology.core;
+					value = topology.numCores++;
+				} else if ( buffer[i].Relationship == RelationNumaNode ) {
+					target = topology.node;
+					value = topology.numNodes++;
+				} else
+					continue;
+
+				ULONG_PTR mask = buffer[i].ProcessorMask;
+				for( int j=0; j<topology.numLogical && j<static_cast<int>(sizeof(mask)*8); j++ ) {
+					if ( mask & (static_cast<ULONG_PTR>(1) << j) )
+						target[j] = value;
+				}
+			}
+		}
+		free( buffer );
+	}
+
+#elif OG_LINUX
+	// Only processors up to the last one in the affinity mask matter,
+	// cpusets and taskset can restrict the process to a few of them.
+	cpu_set_t cpuSet;
+	CPU_ZERO( &cpuSet );
+	if ( sched_getaffinity( 0, sizeof(cpuSet), &cpuSet ) == 0 && CPU_COUNT( &cpuSet ) > 0 ) {
+		int last = 0;
+		for( int i=0; i<CPU::Topology::MAX_LOGICAL; i++ ) {
+			if ( CPU_ISSET( i, &cpuSet ) ) {
+				topology.usable |= static_cast<uLongLong>(1) << i;
+				last = i;
+			}
+		}
+		topology.numLogical = last + 1;
+	} else {
+		int num = sysconf( _SC_NPROCESSORS_ONLN );
+		topology.numLogical = Clamp( num, 1, CPU::Topology::MAX_LOGICAL );
+	}
+
+	// Cores are unique per ( package, core_id ) pair
+	int package[CPU::Topology::MAX_LOGICAL];
+	int coreId[CPU::Topology::MAX_LOGICAL];
+	char path[128], buffer[256];
+	for( int i=0; i<topology.numLogical; i++ ) {
+		package[i] = coreId[i] = -1;
+		sprintf( path, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i );
+		if ( ReadSysFile( path, buffer, sizeof(buffer) ) )
+			package[i] = atoi( buffer );
+		sprintf( path, "/sys/devices/system/cpu/cpu%d/topology/core_id", i );
+		if ( !ReadSysFile( path, buffer, sizeof(buffer) ) )
+			continue;
+		coreId[i] = atoi( buffer );
+
+		for( int j=0; j<i; j++ ) {
+			if ( package[j] == package[i] && coreId[j] == coreId[i] ) {
+				topology.core[i] = topology.core[j];
+				break;
+			}
+		}
+		if ( topology.core[i] == -1 )
+			topology.core[i] = topology.numCores++;
+	}
+
+	// Nodes list their processors as ranges, like "0-5,12-17"
+	for( int n=0; n<CPU::Topology::MAX_LOGICAL; n++ ) {
+		sprintf( path, "/sys/devices/system/node/node%d/cpulist", n );
+		if ( !ReadSysFile( path, buffer, sizeof(buffer) ) )
+			continue;
+		int node = topology.numNodes++;
+		char *p = buffer;
+		while( *p >= '0' && *p <= '9' ) {
+			int first = strtol( p, &p, 10 );
+			int last = first;
+			if ( *p == '-' )
+				last = strtol( p+1, &p, 10 );
+			for( int i=first; i<=last && i<topology.numLogical; i++ )
+				topology.node[i] = node;
+			if ( *p == ',' )
+				p++;
+		}
+	}
+#elif OG_MACOS_X
+	#warning "Need MacOS here FIXME"
+#endif
+
+	// Fill the gaps
+	if ( topology.numNodes == 0 )
+		topology.numNodes = 1;
+	for( int i=0; i<topology.numLogical; i++ ) {
+		if ( topology.core[i] == -1 )
+			topology.core[i] = topology.numCores++;
+		if ( topology.node[i] == -1 )
+			topology.node[i] = 0;
+	}
+
+	// Count what the process may actually use
+	uLongLong all = ( topology.numLogical < 64 ) ? ( static_cast<uLongLong>(1) << topology.numLogical ) - 1 : ~static_cast<uLongLong>(0);
+	topology.usable &= all;
+	if ( topology.usable == 0 )
+		topology.usable = all;
+	topology.numUsable = 0;
+	topology.numUsableCores = 0;
+	for( int i=0; i<topology.numLogical; i++ ) {
+		if ( !( topology.usable & (static_cast<uLongLong>(1) << i) ) )
+			continue;
+		topology.numUsable++;
+
+		bool newCore = true;
+		for( int j=0; j<i; j++ ) {
+			if ( ( topology.usable & (static_cast<uLongLong>(1) << j) ) && topology.core[j] == topology.core[i] ) {
+				newCore = false;
+				break;
+			}
+		}
+		if ( newCore )
+			topology.numUsableCores++;
+	}
+}
 
 // Init SysInfo
 struct Initializer {
@@ -513,6 +693,7 @@ struct Initializer {
 		RetrieveCPUInfo();
 		RetrieveCPUSpeed();
 		RetrieveMemorySize();
+		RetrieveTopology();
 	}
 };
 static Initializer initializer;